@@ -0,0 +1,75 @@
+// Entity scaling benchmark: fills the default world with enemies and times
+// the full simulation step (AI, physics, animation) as the count grows.
+//
+// usage: bench_actors [steps]   (default 600)
+#include "World.hpp"
+#include "core/ResourceManager.hpp"
+#include "graphics/AnimationClip.hpp"
+#include "level/Level.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    int steps = argc > 1 ? std::atoi(argv[1]) : 600;
+    if (steps <= 0)
+    {
+        std::cerr << "usage: bench_actors [steps]" << std::endl;
+        return 1;
+    }
+
+    // clips make the animation system do real work, run next to assets.pak
+    // (it also has the level)
+    ResourceManager resources;
+    resources.mountPack(Paths::ASSET_PACK);
+    auto enemyAnimations = std::make_shared<AnimationLibrary>();
+    Level level;
+    if (!enemyAnimations->loadFromFile(Paths::NIGHTBORNE_ANIMATIONS, resources) ||
+        !level.loadFromFile(Paths::LEVEL_1, resources))
+    {
+        return 1;
+    }
+
+    const float deltaTime = Simulation::FIXED_TIMESTEP;
+
+    std::cout << std::setw(10) << "enemies" << std::setw(14) << "ms/step" << std::setw(14) << "ns/enemy" << std::endl;
+
+    for (int count : {1000, 5000, 20000, 50000})
+    {
+        World world;
+        world.loadLevel(level);
+        world.setEnemyAnimations(enemyAnimations);
+
+        // spread over the floor, half of them in chase range of the player
+        for (int i = 0; i < count; i++)
+        {
+            float x = 40.f + static_cast<float>(i % 940);
+            float y = 900.f - static_cast<float>((i / 940) % 8) * 4.f;
+            world.spawnEnemy({x, y});
+        }
+
+        // let everyone land first
+        for (int i = 0; i < 120; i++)
+        {
+            world.step(deltaTime, PlayerInput());
+        }
+
+        ActionBits previousHeld = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < steps; i++)
+        {
+            ActionBits held = (i / 120) % 2 == 0 ? actionBit(Action::MoveRight) : actionBit(Action::MoveLeft);
+            world.step(deltaTime, PlayerInput::fromHeld(held, previousHeld));
+            previousHeld = held;
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / steps;
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(3) << std::setw(14) << nanoseconds / 1e6
+                  << std::setprecision(1) << std::setw(14) << nanoseconds / count << std::endl;
+    }
+
+    return 0;
+}
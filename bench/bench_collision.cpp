@@ -0,0 +1,70 @@
+// Microbenchmark for CollisionGrid::query: time per player-sized query as the
+// number of static tiles grows. Query time should stay flat.
+#include "physics/CollisionGrid.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main()
+{
+    const float tileSize = 32.f;
+    const int queryCount = 200000;
+    const std::size_t tileCounts[] = {100, 1000, 10000, 100000, 1000000};
+
+    std::cout << std::setw(10) << "tiles"
+              << std::setw(14) << "ns/query"
+              << std::setw(14) << "hits/query" << std::endl;
+
+    for (std::size_t tileCount : tileCounts)
+    {
+        // square map, one floor row every 4 tile rows
+        int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(tileCount) * 4.0)));
+
+        CollisionGrid grid(tileSize, tileSize);
+        for (std::size_t i = 0; i < tileCount; i++)
+        {
+            int column = static_cast<int>(i % columns);
+            int row = static_cast<int>(i / columns) * 4;
+            grid.insert(sf::FloatRect({column * tileSize, row * tileSize}, {tileSize, tileSize}));
+        }
+
+        float mapWidth = columns * tileSize;
+        float mapHeight = (static_cast<float>(tileCount) / columns) * 4.f * tileSize;
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> randomX(0.f, mapWidth);
+        std::uniform_real_distribution<float> randomY(0.f, mapHeight);
+
+        std::vector<sf::FloatRect> regions;
+        regions.reserve(queryCount);
+        for (int i = 0; i < queryCount; i++)
+        {
+            regions.push_back(sf::FloatRect({randomX(rng), randomY(rng)}, {24.f, 48.f}));
+        }
+
+        std::vector<sf::FloatRect> hits;
+        std::uint64_t totalHits = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (const sf::FloatRect &region : regions)
+        {
+            hits.clear();
+            grid.query(region, hits);
+            totalHits += hits.size();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+        std::cout << std::setw(10) << tileCount
+                  << std::setw(14) << std::fixed << std::setprecision(1) << nanoseconds / queryCount
+                  << std::setw(14) << std::setprecision(2) << static_cast<double>(totalHits) / queryCount
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Job system scaling benchmark: runs a crowded world with 1, 2, 4 ... N
+// threads and prints ms/step and speedup. Every run must end in the same
+// state as the single-threaded one, the checksum column shows that.
+//
+// usage: bench_jobs [enemies] [steps]   (default 20000, 300)
+#include "World.hpp"
+#include "core/JobSystem.hpp"
+#include "core/ResourceManager.hpp"
+#include "graphics/AnimationClip.hpp"
+#include "level/Level.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    int enemies = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 300;
+    if (enemies <= 0 || steps <= 0)
+    {
+        std::cerr << "usage: bench_jobs [enemies] [steps]" << std::endl;
+        return 1;
+    }
+
+    // clips make the animation system do real work, run next to assets.pak
+    // (it also has the level)
+    ResourceManager resources;
+    resources.mountPack(Paths::ASSET_PACK);
+    auto enemyAnimations = std::make_shared<AnimationLibrary>();
+    Level level;
+    if (!enemyAnimations->loadFromFile(Paths::NIGHTBORNE_ANIMATIONS, resources) ||
+        !level.loadFromFile(Paths::LEVEL_1, resources))
+    {
+        return 1;
+    }
+
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < hardwareThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    const float deltaTime = Simulation::FIXED_TIMESTEP;
+    double serialMilliseconds = 0.0;
+    std::uint64_t serialChecksum = 0;
+
+    std::cout << enemies << " enemies, " << steps << " steps" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "ms/step" << std::setw(10) << "speedup"
+              << std::setw(20) << "checksum" << std::endl;
+
+    for (unsigned int threads : threadCounts)
+    {
+        JobSystem jobs(threads);
+        World world;
+        world.loadLevel(level);
+        world.setEnemyAnimations(enemyAnimations);
+        world.setJobSystem(&jobs);
+
+        for (int i = 0; i < enemies; i++)
+        {
+            float x = 40.f + static_cast<float>(i % 940);
+            float y = 900.f - static_cast<float>((i / 940) % 8) * 4.f;
+            world.spawnEnemy({x, y});
+        }
+
+        ActionBits previousHeld = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < steps; i++)
+        {
+            ActionBits held = (i / 120) % 2 == 0 ? actionBit(Action::MoveRight) : actionBit(Action::MoveLeft);
+            world.step(deltaTime, PlayerInput::fromHeld(held, previousHeld));
+            previousHeld = held;
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double milliseconds = std::chrono::duration<double, std::milli>(end - start).count() / steps;
+        std::uint64_t checksum = world.getStateHash();
+        if (threads == 1)
+        {
+            serialMilliseconds = milliseconds;
+            serialChecksum = checksum;
+        }
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(3) << std::setw(12) << milliseconds
+                  << std::setprecision(2) << std::setw(9) << serialMilliseconds / milliseconds << "x"
+                  << "  0x" << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec << std::setfill(' ')
+                  << (checksum == serialChecksum ? "" : "  MISMATCH") << std::endl;
+
+        if (checksum != serialChecksum)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+// Level load benchmark: a 1000x1000 map (1,000,000 tiles) is written to a
+// temporary file, then timed through each stage of loading it: the bulk
+// file read, filling Ground, and building the collision boxes. Filling the
+// same map one addTile at a time is timed too, for comparison. Last, the
+// map is streamed under a camera flying across it in real time at 120 Hz,
+// checking the resident tile cap holds and whether the view is ever missing
+// ground.
+#include "Constants.hpp"
+#include "components/Ground.hpp"
+#include "core/ResourceManager.hpp"
+#include "level/Level.hpp"
+#include "level/LevelStreamer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace
+{
+    double millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int runs = argc > 1 ? std::atoi(argv[1]) : 5;
+    if (runs <= 0)
+    {
+        std::cerr << "usage: bench_level [runs]" << std::endl;
+        return 1;
+    }
+
+    const std::uint32_t size = 1000;
+    const std::uint32_t tilesetColumns = 16;
+
+    // every cell drawn, about 60% of them solid in random caves
+    Level source;
+    source.create(size, size, 32, 32, tilesetColumns, 1, true);
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> tile(1, 64);
+    std::bernoulli_distribution solid(0.6);
+    for (std::uint32_t y = 0; y < size; y++)
+    {
+        for (std::uint32_t x = 0; x < size; x++)
+        {
+            source.setTile(0, x, y, static_cast<std::uint16_t>(tile(rng)));
+            source.setSolid(x, y, solid(rng));
+        }
+    }
+
+    std::string path = (std::filesystem::temp_directory_path() / "bench_level.lvl").string();
+    if (!source.saveToFile(path))
+    {
+        return 1;
+    }
+    double megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    ResourceManager resources;
+    double readTotal = 0.0, fillTotal = 0.0, collisionTotal = 0.0, addTileTotal = 0.0;
+
+    for (int run = 0; run < runs; run++)
+    {
+        Level level;
+        auto start = std::chrono::steady_clock::now();
+        if (!level.loadFromFile(path, resources))
+        {
+            return 1;
+        }
+        readTotal += millisecondsSince(start);
+
+        Ground ground(32, 32);
+        start = std::chrono::steady_clock::now();
+        ground.loadLevel(level);
+        fillTotal += millisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        ground.updateCollision();
+        collisionTotal += millisecondsSince(start);
+
+        // the old way: one addTile per tile, chunks regrowing as they fill
+        Ground tileByTile(32, 32);
+        start = std::chrono::steady_clock::now();
+        for (std::uint32_t y = 0; y < size; y++)
+        {
+            for (std::uint32_t x = 0; x < size; x++)
+            {
+                int index = level.getTile(0, x, y) - 1;
+                tileByTile.addTile(x * 32.f, y * 32.f, index % static_cast<int>(tilesetColumns), index / static_cast<int>(tilesetColumns));
+            }
+        }
+        addTileTotal += millisecondsSince(start);
+    }
+
+    // streaming: 4 s diagonal flight at 2000 px/s, paced like the game loop
+    const float flightSpeed = 2000.f;
+    const int flightSteps = 480;
+    const auto stepDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(Simulation::FIXED_TIMESTEP));
+
+    LevelStreamer streamer(StreamingSettings{Streaming::LOAD_RADIUS, Streaming::UNLOAD_RADIUS, Streaming::MAX_RESIDENT_TILES});
+    Ground streamed(32, 32);
+    if (!streamer.open(path, resources) || !streamed.beginStreaming(streamer.getFile().getInfo()))
+    {
+        return 1;
+    }
+
+    sf::Vector2f center(1000.f, 1000.f);
+    double updateMaxMs = 0.0;
+    std::size_t peakTiles = 0, peakBytes = 0, missingViewSteps = 0;
+    auto nextStep = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < flightSteps; step++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        streamer.update(center, streamed);
+        streamed.updateCollision(); // what the next physics step would do
+        updateMaxMs = std::max(updateMaxMs, millisecondsSince(start));
+
+        const StreamingStats &stats = streamer.getStats();
+        peakTiles = std::max(peakTiles, stats.residentTiles);
+        peakBytes = std::max(peakBytes, stats.residentBytes);
+        if (!streamed.isLoaded(sf::FloatRect(center - sf::Vector2f(400.f, 300.f), {800.f, 600.f})))
+        {
+            missingViewSteps++;
+        }
+
+        center += sf::Vector2f(flightSpeed, flightSpeed) * (Simulation::FIXED_TIMESTEP / std::sqrt(2.f));
+        nextStep += stepDuration;
+        std::this_thread::sleep_until(nextStep);
+    }
+
+    const StreamingStats &stats = streamer.getStats();
+    std::filesystem::remove(path);
+
+    std::cout << "tiles:           " << size * size << " (" << std::fixed << std::setprecision(1) << megabytes << " MB file)" << std::endl;
+    std::cout << "read file:       " << std::setprecision(2) << readTotal / runs << " ms" << std::endl;
+    std::cout << "fill ground:     " << fillTotal / runs << " ms" << std::endl;
+    std::cout << "build collision: " << collisionTotal / runs << " ms" << std::endl;
+    std::cout << "addTile loop:    " << addTileTotal / runs << " ms" << std::endl;
+
+    std::cout << "streaming:       " << stats.loadsCompleted << " loads, " << stats.evictions << " evictions over "
+              << flightSteps << " steps at " << flightSpeed << " px/s" << std::endl;
+    std::cout << "  load latency:  " << stats.averageLoadMs << " ms avg, " << stats.maxLoadMs << " ms max" << std::endl;
+    std::cout << "  sim thread:    " << updateMaxMs << " ms max per step (swap-in and collision)" << std::endl;
+    std::cout << "  resident peak: " << peakTiles << " tiles (" << peakBytes / 1024 << " KB), cap "
+              << Streaming::MAX_RESIDENT_TILES << std::endl;
+    std::cout << "  view missing:  " << missingViewSteps << " steps" << std::endl;
+
+    if (peakTiles > Streaming::MAX_RESIDENT_TILES)
+    {
+        std::cerr << "resident tiles went over the cap" << std::endl;
+        return 1;
+    }
+    return 0;
+}
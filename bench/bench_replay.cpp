@@ -0,0 +1,102 @@
+// Replay benchmark: plays an input recording (made with the game's --record
+// or bench_sim --record) back in a headless world. The first run checks the
+// world state hash after every step against the recording and stops at the
+// first step that differs; the runs after that are timed without hashing,
+// only the final hash is checked.
+//
+// usage: bench_replay <recording> [runs]   (default 5)
+#include "World.hpp"
+#include "core/ResourceManager.hpp"
+#include "graphics/AnimationClip.hpp"
+#include "input/InputRecording.hpp"
+#include "level/Level.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+int main(int argc, char **argv)
+{
+    int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (argc < 2 || runs <= 0)
+    {
+        std::cerr << "usage: bench_replay <recording> [runs]" << std::endl;
+        return 1;
+    }
+
+    InputRecording recording;
+    if (!recording.loadFromFile(argv[1]))
+    {
+        return 1;
+    }
+    if (recording.getTickCount() == 0)
+    {
+        std::cerr << "recording has no steps" << std::endl;
+        return 1;
+    }
+
+    // level and animation clips come from assets.pak, run from the directory it is in
+    ResourceManager resources;
+    resources.mountPack(Paths::ASSET_PACK);
+    auto animations = std::make_shared<AnimationLibrary>();
+    auto enemyAnimations = std::make_shared<AnimationLibrary>();
+    Level level;
+    if (!animations->loadFromFile(Paths::KNIGHT_ANIMATIONS, resources) ||
+        !enemyAnimations->loadFromFile(Paths::NIGHTBORNE_ANIMATIONS, resources) ||
+        !level.loadFromFile(recording.getLevelPath(), resources))
+    {
+        return 1;
+    }
+
+    const float deltaTime = recording.getTimestep();
+    const std::size_t ticks = recording.getTickCount();
+    double bestNanoseconds = 0.0, totalNanoseconds = 0.0;
+
+    for (int run = 0; run <= runs; run++)
+    {
+        World world;
+        world.loadLevel(level);
+        world.getPlayer().setAnimations(animations);
+        world.setEnemyAnimations(enemyAnimations);
+
+        // run 0 verifies every step
+        if (run == 0)
+        {
+            for (std::size_t tick = 0; tick < ticks; tick++)
+            {
+                world.step(deltaTime, recording.getInput(tick));
+                if (world.getStateHash() != recording.getStateHash(tick))
+                {
+                    std::cerr << "replay diverged from the recording at step " << tick << std::endl;
+                    return 1;
+                }
+            }
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t tick = 0; tick < ticks; tick++)
+        {
+            world.step(deltaTime, recording.getInput(tick));
+        }
+        double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        if (world.getStateHash() != recording.getStateHash(ticks - 1))
+        {
+            std::cerr << "timed run " << run << " ended in a different state" << std::endl;
+            return 1;
+        }
+
+        totalNanoseconds += nanoseconds;
+        bestNanoseconds = run == 1 ? nanoseconds : std::min(bestNanoseconds, nanoseconds);
+    }
+
+    std::cout << "steps:        " << ticks << " (" << std::fixed << std::setprecision(1)
+              << static_cast<double>(ticks) * deltaTime << " s of play)" << std::endl;
+    std::cout << "state hashes: all " << ticks << " match" << std::endl;
+    std::cout << "ns/step:      " << bestNanoseconds / static_cast<double>(ticks) << " best, "
+              << totalNanoseconds / runs / static_cast<double>(ticks) << " mean of " << runs << " runs" << std::endl;
+    return 0;
+}
@@ -0,0 +1,188 @@
+// Headless simulation benchmark: runs the default world (player and a few
+// enemies) for a number of fixed steps with scripted input and no window.
+// Reports ns/step, heap allocations per step and a checksum of the final
+// state, so runs can be compared. With --record the same scripted run is
+// also saved as an input recording for bench_replay.
+//
+// usage: bench_sim [steps] [--record file]   (default 100000)
+#include "World.hpp"
+#include "core/Hash.hpp"
+#include "core/ResourceManager.hpp"
+#include "graphics/AnimationClip.hpp"
+#include "input/InputRecording.hpp"
+#include "level/Level.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+static std::atomic<std::uint64_t> g_allocations{0};
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// deterministic input: walk right and left in turns, hop and swing regularly
+static ActionBits scriptedActions(int step)
+{
+    int phase = step % 720;
+    ActionBits held = 0;
+    held |= phase < 300 ? actionBit(Action::MoveRight) : 0;
+    held |= phase >= 360 && phase < 660 ? actionBit(Action::MoveLeft) : 0;
+    held |= step % 150 < 10 ? actionBit(Action::Jump) : 0;
+    held |= step % 97 < 2 ? actionBit(Action::Attack) : 0;
+    return held;
+}
+
+static PlayerInput scriptedInput(int step)
+{
+    return PlayerInput::fromHeld(scriptedActions(step), step > 0 ? scriptedActions(step - 1) : 0);
+}
+
+static std::uint64_t worldChecksum(const World &world)
+{
+    std::uint64_t hash = Hash::FNV_OFFSET;
+
+    const Player &player = world.getPlayer();
+    sf::Vector2f position = player.getPosition();
+    sf::Vector2f velocity = player.getVelocity();
+    sf::Vector2f camera = world.getCamera().getCenter();
+    bool onGround = player.isOnGround();
+
+    Hash::addBytes(hash, &position, sizeof(position));
+    Hash::addBytes(hash, &velocity, sizeof(velocity));
+    Hash::addBytes(hash, &camera, sizeof(camera));
+    Hash::addBytes(hash, &onGround, sizeof(onGround));
+
+    return hash;
+}
+
+int main(int argc, char **argv)
+{
+    int steps = 100000;
+    std::string recordPath;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+        else
+        {
+            steps = std::atoi(argv[i]);
+        }
+    }
+    if (steps <= 0)
+    {
+        std::cerr << "usage: bench_sim [steps] [--record file]" << std::endl;
+        return 1;
+    }
+
+    const float deltaTime = Simulation::FIXED_TIMESTEP;
+
+    World world;
+
+    // the level and the animation clips (they time the attack) come from
+    // assets.pak, run from the directory it is in
+    ResourceManager resources;
+    resources.mountPack(Paths::ASSET_PACK);
+    auto animations = std::make_shared<AnimationLibrary>();
+    auto enemyAnimations = std::make_shared<AnimationLibrary>();
+    if (!animations->loadFromFile(Paths::KNIGHT_ANIMATIONS, resources) ||
+        !enemyAnimations->loadFromFile(Paths::NIGHTBORNE_ANIMATIONS, resources))
+    {
+        return 1;
+    }
+
+    Level level;
+    if (!level.loadFromFile(Paths::LEVEL_1, resources))
+    {
+        return 1;
+    }
+    world.loadLevel(level);
+    world.getPlayer().setAnimations(animations);
+    world.setEnemyAnimations(enemyAnimations);
+
+    // warm up once so lazily built structures are not charged to the loop
+    world.step(deltaTime, PlayerInput());
+
+    std::uint64_t allocationsBefore = g_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < steps; i++)
+    {
+        world.step(deltaTime, scriptedInput(i));
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::uint64_t allocations = g_allocations.load() - allocationsBefore;
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    sf::Vector2f position = world.getPlayer().getPosition();
+
+    std::cout << "steps:            " << steps << std::endl;
+    std::cout << "ns/step:          " << std::fixed << std::setprecision(1) << nanoseconds / steps << std::endl;
+    std::cout << "allocations/step: " << std::setprecision(4) << static_cast<double>(allocations) / steps << std::endl;
+    std::cout << "final position:   " << std::setprecision(3) << position.x << ", " << position.y << std::endl;
+    std::cout << "checksum:         0x" << std::hex << std::setw(16) << std::setfill('0') << worldChecksum(world) << std::endl;
+
+    // recorded from a fresh world, untimed, so the benchmark above stays as it was
+    if (!recordPath.empty())
+    {
+        World recorded;
+        recorded.loadLevel(level);
+        recorded.getPlayer().setAnimations(animations);
+        recorded.setEnemyAnimations(enemyAnimations);
+
+        InputRecording recording;
+        recording.reset(deltaTime, Paths::LEVEL_1);
+        for (int i = 0; i < steps; i++)
+        {
+            PlayerInput input = scriptedInput(i);
+            recorded.step(deltaTime, input);
+            recording.record(input, recorded.getStateHash());
+        }
+
+        if (!recording.saveToFile(recordPath))
+        {
+            return 1;
+        }
+        std::cout << "recorded:         " << std::dec << steps << " steps to " << recordPath << std::endl;
+    }
+
+    return 0;
+}
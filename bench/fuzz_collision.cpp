@@ -0,0 +1,150 @@
+// Randomised tunneling test for PhysicsSystem: bodies are boxed into cells
+// of thin ground walls and thrown around at up to 10,000 px/s with uneven
+// timesteps and gravity. After every step each body has to still be inside
+// its own cell and must not sink into a wall deeper than SWEEP_SKIN.
+// Exits with an error on the first seed that fails, so it can gate CI.
+#include "components/Ground.hpp"
+#include "ecs/PhysicsSystem.hpp"
+#include "ecs/Registry.hpp"
+#include "physics/SweptAabb.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Body
+    {
+        Entity entity;
+        sf::FloatRect cell; // open space the body has to stay in
+    };
+
+    struct SeedResult
+    {
+        std::uint64_t bodySteps;
+        std::uint64_t failures;
+        float worstPenetration;
+    };
+
+    SeedResult runSeed(std::uint32_t seed, int steps)
+    {
+        std::mt19937 rng(seed);
+
+        // one tile thick walls, the thinnest thing a body could skip over
+        int tileSize = std::uniform_int_distribution<int>(4, 32)(rng);
+        int cellTiles = std::uniform_int_distribution<int>(3, 8)(rng);
+        int cellsPerSide = std::uniform_int_distribution<int>(2, 5)(rng);
+        int mapTiles = cellsPerSide * (cellTiles + 1) + 1;
+        float tile = static_cast<float>(tileSize);
+
+        Ground ground(tileSize, tileSize);
+        for (int line = 0; line < mapTiles; line += cellTiles + 1)
+        {
+            ground.createHorizontalPlatform(0.f, line * tile, mapTiles, 0, 0);
+            ground.createVerticalPlatform(line * tile, tile, mapTiles - 2, 0, 0);
+        }
+
+        Registry registry;
+        PhysicsSystem physics;
+        std::vector<Body> bodies;
+
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        float cellSize = cellTiles * tile;
+        for (int cellY = 0; cellY < cellsPerSide; cellY++)
+        {
+            for (int cellX = 0; cellX < cellsPerSide; cellX++)
+            {
+                sf::FloatRect cell({(cellX * (cellTiles + 1) + 1) * tile, (cellY * (cellTiles + 1) + 1) * tile},
+                                   {cellSize, cellSize});
+
+                for (int n = 0; n < 4; n++)
+                {
+                    sf::Vector2f size(cellSize * (0.1f + 0.8f * unit(rng)), cellSize * (0.1f + 0.8f * unit(rng)));
+                    sf::Vector2f center(cell.position.x + size.x / 2.f + (cellSize - size.x) * unit(rng),
+                                        cell.position.y + size.y / 2.f + (cellSize - size.y) * unit(rng));
+
+                    Entity entity = registry.create(center);
+                    registry.colliders.localBox[registry.indexOf(entity)] = {-size / 2.f, size};
+                    bodies.push_back({entity, cell});
+                }
+            }
+        }
+
+        std::uniform_real_distribution<float> speed(-10000.f, 10000.f);
+        std::uniform_real_distribution<float> timestep(0.0005f, 1.f / 30.f);
+        std::uniform_real_distribution<float> gravity(-5000.f, 5000.f);
+
+        SeedResult result{0, 0, 0.f};
+        for (int step = 0; step < steps; step++)
+        {
+            for (const Body &body : bodies)
+            {
+                std::size_t i = registry.indexOf(body.entity);
+                // mostly keep momentum so bodies also rest and slide on walls
+                if (unit(rng) < 0.3f)
+                {
+                    registry.velocities.velocity[i] = {speed(rng), speed(rng)};
+                    registry.velocities.gravity[i] = gravity(rng);
+                }
+            }
+
+            physics.update(registry, ground, timestep(rng), nullptr);
+
+            for (const Body &body : bodies)
+            {
+                std::size_t i = registry.indexOf(body.entity);
+                sf::FloatRect box = registry.colliders.localBox[i];
+                box.position += registry.transforms.position[i];
+
+                // how far the box reaches past its cell into the walls
+                float penetration = std::max({body.cell.position.x - box.position.x,
+                                              body.cell.position.y - box.position.y,
+                                              box.position.x + box.size.x - (body.cell.position.x + body.cell.size.x),
+                                              box.position.y + box.size.y - (body.cell.position.y + body.cell.size.y),
+                                              0.f});
+
+                result.worstPenetration = std::max(result.worstPenetration, penetration);
+                if (penetration > SWEEP_SKIN)
+                {
+                    result.failures++;
+                }
+                result.bodySteps++;
+            }
+        }
+
+        return result;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::uint32_t firstSeed = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1;
+    int seedCount = argc > 2 ? std::atoi(argv[2]) : 100;
+    const int steps = 2000;
+
+    std::uint64_t bodySteps = 0;
+    float worstPenetration = 0.f;
+
+    for (std::uint32_t seed = firstSeed; seed < firstSeed + static_cast<std::uint32_t>(seedCount); seed++)
+    {
+        SeedResult result = runSeed(seed, steps);
+        bodySteps += result.bodySteps;
+        worstPenetration = std::max(worstPenetration, result.worstPenetration);
+
+        if (result.failures > 0)
+        {
+            std::cerr << "Error: seed " << seed << " left " << result.failures
+                      << " bodies outside their cell, worst by " << result.worstPenetration << " px" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "seeds:             " << seedCount << " (from " << firstSeed << ")" << std::endl;
+    std::cout << "body steps:        " << bodySteps << std::endl;
+    std::cout << "worst penetration: " << std::fixed << std::setprecision(5) << worstPenetration << " px" << std::endl;
+    return 0;
+}
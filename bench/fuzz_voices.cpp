@@ -0,0 +1,250 @@
+// Randomised test of AudioSystem's voice stealing, on AudioSystem::chooseVoice
+// alone so it needs no audio device. Each seed plays a stream of sounds of
+// random priority, length and buffer into a pool of voices on a simulated
+// clock, and every pick has to be: a free voice holding the sound's buffer if
+// there is one, else a free voice, else the lowest priority playing voice
+// (the oldest of those), and never one above the new sound's priority.
+// Two fixed cases cover the game's own use: a burst of sword slashes, and a
+// higher priority sound under a flood of lower ones.
+// Exits with an error on the first seed that fails, so it can gate CI.
+#include "audio/AudioSystem.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using VoiceState = AudioSystem::VoiceState;
+
+    // a simulated voice: the state play() sees plus what the test tracks
+    struct Pool
+    {
+        std::vector<VoiceState> states;
+        std::vector<int> buffers; // which sound each voice last played
+        std::vector<double> endsAt;
+        std::uint64_t playCount = 0;
+
+        explicit Pool(std::size_t voices)
+            : states(voices, VoiceState{false, false, 0, 0}),
+              buffers(voices, -1),
+              endsAt(voices, 0.0)
+        {
+        }
+
+        // what play() would see at time now for a sound on buffer
+        void observe(double now, int buffer)
+        {
+            for (std::size_t i = 0; i < states.size(); i++)
+            {
+                states[i].playing = now < endsAt[i];
+                states[i].holdsBuffer = buffers[i] == buffer;
+            }
+        }
+
+        void start(int voice, double now, int buffer, int priority, double length)
+        {
+            std::size_t i = static_cast<std::size_t>(voice);
+            buffers[i] = buffer;
+            endsAt[i] = now + length;
+            states[i].priority = priority;
+            states[i].startedAt = ++playCount;
+        }
+    };
+
+    bool before(const VoiceState &a, const VoiceState &b)
+    {
+        return a.priority != b.priority ? a.priority < b.priority : a.startedAt < b.startedAt;
+    }
+
+    // empty if chosen is right for these states, otherwise why not
+    std::string checkChoice(const std::vector<VoiceState> &states, int priority, int chosen)
+    {
+        bool anyFree = false;
+        bool anyFreeWithBuffer = false;
+        const VoiceState *lowest = nullptr;
+        for (const VoiceState &state : states)
+        {
+            anyFree = anyFree || !state.playing;
+            anyFreeWithBuffer = anyFreeWithBuffer || (!state.playing && state.holdsBuffer);
+            if (state.playing && (!lowest || before(state, *lowest)))
+            {
+                lowest = &state;
+            }
+        }
+
+        if (chosen < -1 || chosen >= static_cast<int>(states.size()))
+        {
+            return "picked voice " + std::to_string(chosen) + " out of range";
+        }
+        if (chosen == -1)
+        {
+            if (anyFree)
+            {
+                return "refused a sound with a voice free";
+            }
+            if (lowest->priority <= priority)
+            {
+                return "refused a sound that could take a priority " + std::to_string(lowest->priority) + " voice";
+            }
+            return "";
+        }
+
+        const VoiceState &voice = states[static_cast<std::size_t>(chosen)];
+        if (anyFree)
+        {
+            if (voice.playing)
+            {
+                return "stole a voice with one free";
+            }
+            if (anyFreeWithBuffer && !voice.holdsBuffer)
+            {
+                return "took a free voice on another buffer over one holding the sound's";
+            }
+            return "";
+        }
+        if (voice.priority > priority)
+        {
+            return "cut off priority " + std::to_string(voice.priority) + " for priority " + std::to_string(priority);
+        }
+        if (&voice != lowest)
+        {
+            return "stole a voice that was not the lowest priority, oldest one";
+        }
+        return "";
+    }
+
+    // returns the first failure, empty if none
+    std::string runSeed(std::uint32_t seed, int plays)
+    {
+        std::mt19937 rng(seed);
+        std::size_t voiceCount = static_cast<std::size_t>(std::uniform_int_distribution<int>(1, 32)(rng));
+        int bufferCount = std::uniform_int_distribution<int>(1, 4)(rng);
+        int priorityCount = std::uniform_int_distribution<int>(1, 4)(rng);
+        // busy enough that some seeds keep every voice taken
+        double meanGap = std::uniform_real_distribution<double>(0.005, 0.2)(rng);
+
+        Pool pool(voiceCount);
+        double now = 0.0;
+        for (int play = 0; play < plays; play++)
+        {
+            now += std::exponential_distribution<double>(1.0 / meanGap)(rng);
+            int buffer = std::uniform_int_distribution<int>(0, bufferCount - 1)(rng);
+            int priority = std::uniform_int_distribution<int>(0, priorityCount - 1)(rng);
+            double length = std::uniform_real_distribution<double>(0.05, 2.0)(rng);
+
+            pool.observe(now, buffer);
+            int chosen = AudioSystem::chooseVoice(pool.states, priority);
+            std::string failure = checkChoice(pool.states, priority, chosen);
+            if (!failure.empty())
+            {
+                return "play " + std::to_string(play) + ": " + failure;
+            }
+            if (chosen >= 0)
+            {
+                pool.start(chosen, now, buffer, priority, length);
+            }
+        }
+        return "";
+    }
+
+    // 40 slashes in a row on 16 voices, none finished: every one plays, and
+    // the 16 left playing are the 16 newest
+    std::string checkSlashBurst()
+    {
+        Pool pool(16);
+        for (int slash = 0; slash < 40; slash++)
+        {
+            pool.observe(0.0, 0);
+            int chosen = AudioSystem::chooseVoice(pool.states, 0);
+            if (chosen < 0)
+            {
+                return "slash " + std::to_string(slash) + " was refused";
+            }
+            pool.start(chosen, 0.0, 0, 0, 1.0);
+        }
+        for (const VoiceState &state : pool.states)
+        {
+            if (state.startedAt <= pool.playCount - pool.states.size())
+            {
+                return "slash " + std::to_string(state.startedAt) + " outlived newer slashes";
+            }
+        }
+        return "";
+    }
+
+    // one priority 1 sound, then a flood of priority 0: it is never stolen,
+    // and once all 16 voices hold priority 1 a priority 0 sound is refused
+    std::string checkPriorityFlood()
+    {
+        Pool pool(16);
+        pool.observe(0.0, 1);
+        int important = AudioSystem::chooseVoice(pool.states, 1);
+        pool.start(important, 0.0, 1, 1, 10.0);
+        for (int play = 0; play < 100; play++)
+        {
+            pool.observe(0.0, 0);
+            int chosen = AudioSystem::chooseVoice(pool.states, 0);
+            if (chosen < 0)
+            {
+                return "a priority 0 sound was refused over other priority 0 ones";
+            }
+            if (chosen == important)
+            {
+                return "a priority 0 sound cut off the priority 1 one";
+            }
+            pool.start(chosen, 0.0, 0, 0, 10.0);
+        }
+
+        for (int play = 0; play < 16; play++)
+        {
+            pool.observe(0.0, 1);
+            int chosen = AudioSystem::chooseVoice(pool.states, 1);
+            if (chosen < 0)
+            {
+                return "a priority 1 sound was refused over priority 0 ones";
+            }
+            pool.start(chosen, 0.0, 1, 1, 10.0);
+        }
+        pool.observe(0.0, 0);
+        if (AudioSystem::chooseVoice(pool.states, 0) != -1)
+        {
+            return "a priority 0 sound took a voice from a pool of priority 1 ones";
+        }
+        return "";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::uint32_t firstSeed = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1;
+    int seedCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const int plays = 2000;
+
+    std::string failure = checkSlashBurst();
+    if (failure.empty())
+    {
+        failure = checkPriorityFlood();
+    }
+    if (!failure.empty())
+    {
+        std::cerr << "Error: " << failure << std::endl;
+        return 1;
+    }
+
+    for (std::uint32_t seed = firstSeed; seed < firstSeed + static_cast<std::uint32_t>(seedCount); seed++)
+    {
+        failure = runSeed(seed, plays);
+        if (!failure.empty())
+        {
+            std::cerr << "Error: seed " << seed << ", " << failure << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "seeds: " << seedCount << " (from " << firstSeed << "), " << plays << " plays each" << std::endl;
+    std::cout << "fixed cases: slash burst, priority flood" << std::endl;
+    return 0;
+}
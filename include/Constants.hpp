@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 
 namespace Paths
@@ -12,6 +13,9 @@ namespace Paths
     // BASE ASSET PATH
     const std::string ASSET_PATH = "assets/";
 
+    // PACKED ASSETS (built by tools/asset_packer.cpp, keys are the paths below)
+    const std::string ASSET_PACK = "assets.pak";
+
     // FONT
     const std::string FONT_PATH = ASSET_PATH + "fonts/Lexend/static/Lexend-Regular.ttf";
 
@@ -21,6 +25,69 @@ namespace Paths
     const std::string PLAYER_JUMP_TEXTURE = ASSET_PATH + "images/character/player/knight/Jump.png";
     const std::string PLAYER_ATTACK_TEXTURE = ASSET_PATH + "images/character/player/knight/Attacks.png";
 
+    // CHARACTER ATLAS (generated at build time by tools/atlas_packer.cpp)
+    const std::string CHARACTER_ATLAS = ASSET_PATH + "atlas/characters.atlas";
+
+    // ANIMATION CLIPS
+    const std::string KNIGHT_ANIMATIONS = ASSET_PATH + "animations/knight.anim";
+    const std::string NIGHTBORNE_ANIMATIONS = ASSET_PATH + "animations/nightborne.anim";
+
+    // LEVELS (imported at build time from assets/levels/*.json by tools/level_importer.cpp)
+    const std::string LEVEL_1 = ASSET_PATH + "levels/level1.lvl";
+
+    // BACKGROUND LAYERS (back to front, drawn by graphics/ParallaxBackground)
+    const std::string BACKGROUND_LAYER_1 = ASSET_PATH + "images/background/background_layer_1.png";
+    const std::string BACKGROUND_LAYER_2 = ASSET_PATH + "images/background/background_layer_2.png";
+    const std::string BACKGROUND_LAYER_3 = ASSET_PATH + "images/background/background_layer_3.png";
+
+    // PARTICLE FLIPBOOKS (6x6 cells of white flames, tinted per emitter)
+    const std::string FLAME_PARTICLE_TEXTURE = ASSET_PATH + "images/vfx/tx_fx_flame.png";
+    const std::string TORCH_PARTICLE_TEXTURE = ASSET_PATH + "images/vfx/tx_fx_torch_flame.png";
+
     // GROUND TILESET TEXTURE
     const std::string GROUND_TILESET_TEXTURE = ASSET_PATH + "images/tilesets/tx_tileset_ground.png";
-}
\ No newline at end of file
+
+    // AUDIO (music streams from the pack while it plays, effects are decoded once)
+    const std::string MENU_MUSIC = ASSET_PATH + "audio/music/fantasy-orchestral.ogg";
+    const std::string LEVEL_MUSIC = ASSET_PATH + "audio/music/fantasy.ogg";
+    const std::string SWORD_SLASH_SOUND = ASSET_PATH + "audio/sfx/sword-slash.wav";
+
+    // TRACE CAPTURE (written next to the executable, see core/Tracer.hpp)
+    const std::string TRACE_OUTPUT = "trace.json";
+}
+
+namespace Simulation
+{
+    // fixed simulation step (120 Hz) and the most steps run for one rendered
+    // frame, so a long hitch cannot snowball into ever longer catch-up frames
+    const float FIXED_TIMESTEP = 1.f / 120.f;
+    const int MAX_STEPS_PER_FRAME = 8;
+}
+
+namespace Streaming
+{
+    // level regions load inside LOAD_RADIUS of the camera and stay until
+    // they are past UNLOAD_RADIUS; the ground never holds more tiles than
+    // MAX_RESIDENT_TILES (about 140 bytes each with their vertices)
+    const float LOAD_RADIUS = 1200.f;
+    const float UNLOAD_RADIUS = 1600.f;
+    const std::size_t MAX_RESIDENT_TILES = 200000;
+}
+
+namespace Audio
+{
+    // voices for sound effects; past this many at once the lowest priority
+    // one is cut off (see audio/AudioSystem.hpp)
+    const std::size_t VOICE_COUNT = 16;
+    const float MUSIC_VOLUME = 60.f;
+    const float CROSSFADE_SECONDS = 2.f;
+}
+
+namespace Lighting
+{
+    // light map size as a fraction of the window per side, F5 cycles it in
+    // game; lower is cheaper and softer
+    const float RESOLUTION_SCALE = 0.5f;
+    const float TORCH_RADIUS = 140.f;
+    const float PLAYER_RADIUS = 110.f;
+}
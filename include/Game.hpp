@@ -1,10 +1,28 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
 #include <optional>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "Constants.hpp"
-#include "components/Player.hpp"
-#include "components/Ground.hpp"
+#include "World.hpp"
+#include "audio/AudioSystem.hpp"
+#include "core/ResourceManager.hpp"
+#include "core/AssetLoader.hpp"
+#include "core/TripleBuffer.hpp"
+#include "graphics/RenderSnapshot.hpp"
+#include "graphics/ActorRenderer.hpp"
+#include "graphics/LightMap.hpp"
+#include "graphics/ParallaxBackground.hpp"
+#include "graphics/ParticlePool.hpp"
+#include "graphics/ProfilerOverlay.hpp"
+#include "input/ActionInput.hpp"
+#include "input/InputRecording.hpp"
+#include "level/LevelStreamer.hpp"
 #include "scenes/MenuScene.hpp"
 
 enum class GameState
@@ -13,35 +31,109 @@ enum class GameState
     Playing
 };
 
+// Command line options, see main.cpp
+struct GameOptions
+{
+    std::string recordPath; // write every step's input and state hash here on exit
+    std::string replayPath; // play this recording back instead of the keyboard
+    std::size_t testLights = 0; // extra lights scattered over the level, to load the light map
+};
+
 class Game
 {
 public:
-    Game();
+    explicit Game(const GameOptions &options = GameOptions());
     int run();
 
 private:
     void processEvents(const sf::Vector2f &mousePos);
-    void update(float deltaTime, const sf::Vector2f &mousePos);
-    void render();
+    void update(float deltaTime);
+    void stepReplay(float deltaTime);
+    void publishSnapshot();
+    void finishLoading();
+    // flames and lights for the level's torches (and the test lights)
+    void addLevelEffects(const LevelInfo &info, const std::vector<LevelSpawn> &spawns);
+
+    // render thread
+    void renderLoop();
+    void render(const RenderSnapshot &snapshot, float alpha, float deltaTime);
+
+    // Started first, so it covers window creation for time-to-first-frame
+    sf::Clock startupClock;
 
     sf::RenderWindow window;
     GameState gameState;
+    bool running;
+
+    // The window thread polls events, steps the world and publishes
+    // snapshots; the render thread owns the GL context and draws the latest
+    // snapshot. windowMutex guards the window and the menu, which both
+    // threads touch; world state only crosses over through snapshots,
+    // apart from the ground, which locks its chunks while drawing.
+    std::thread renderThread;
+    std::atomic<bool> rendering;
+    std::mutex windowMutex;
+    sf::View menuView;
+    bool showProfiler; // toggled with F3
+    TripleBuffer<RenderSnapshot> snapshots;
+
+    // Shared textures and fonts, filled in the background by the loader
+    ResourceManager resources;
+    AssetLoader loader;
+    std::shared_ptr<SpriteAtlas> atlas;
+    std::shared_ptr<AnimationLibrary> animations;
+    std::shared_ptr<AnimationLibrary> enemyAnimations;
+    bool assetsReady;
+    bool firstFrameShown;
+
+    // Worker threads for the per-entity world systems
+    JobSystem jobs;
+
+    // Key events mapped to actions, drained once per fixed step
+    ActionInput actions;
 
     // Scene / world
     Menu menu;
-    Ground ground;
-    Player player;
+    World world;
+    ActorRenderer actors;
+    ParallaxBackground background;
+
+    // Visual-only effects, simulated on the render thread with the frame
+    // time: flames on the level's torch spawns, sparks off the attack hitbox
+    ParticlePool torchFlames;
+    ParticlePool sparks;
+    std::size_t sparkEmitter;
+
+    // Night lighting over the world (render thread). torchLights are placed
+    // with the level, frameLights adds flicker and the player's glow.
+    LightMap lighting;
+    std::vector<PointLight> torchLights;
+    std::vector<PointLight> frameLights;
+    float lightTime;
+
+    // Music follows the scene, crossfading on a change; effects on the
+    // update thread. Declared after resources, whose pack the music streams from.
+    AudioSystem audio;
+    GameState musicState;
+
+    // Loads the level's regions around the camera; declared after world so
+    // its worker stops before the ground it builds for goes away
+    LevelStreamer streamer;
 
-    // Camera
-    sf::View camera;
-    float cameraSmoothing;
+    // Recording or replaying steps. Both load the whole level up front:
+    // when a streamed region arrives depends on the disk, not the input.
+    GameOptions options;
+    InputRecording recording;
+    std::size_t replayTick;
+    bool replayDiverged;
 
     // Timing
     sf::Clock clock;
+    float fixedTimestep;
+    int maxStepsPerFrame;
+    float accumulator;
 
-    // Map / tiles
-    int mapWidth;
-    int mapHeight;
-    int tileSizeX;
-    int tileSizeY;
+    // Stats (render thread)
+    ProfilerOverlay profilerOverlay;
+    std::chrono::steady_clock::time_point lastFrameStart;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Constants.hpp"
+#include "components/Player.hpp"
+#include "components/Ground.hpp"
+#include "ecs/AnimationSystem.hpp"
+#include "ecs/EnemyAiSystem.hpp"
+#include "ecs/PhysicsSystem.hpp"
+#include "ecs/Registry.hpp"
+#include "input/PlayerInput.hpp"
+#include "level/Level.hpp"
+#include "level/LevelStreamer.hpp"
+
+// Simulation state of a level: ground, the actors in the registry (the
+// player is one of them) and camera. It never touches a window or loads
+// assets, so it can run headless (see bench/bench_sim.cpp).
+class World
+{
+public:
+    World();
+    void step(float deltaTime, const PlayerInput &input);
+
+    // replaces the ground and every enemy, and moves the player to the
+    // level's player spawn; a new World is empty until this is called
+    void loadLevel(const Level &level);
+    // same, but the ground only holds the regions streamer keeps resident
+    // around the camera; it is updated at the start of every step
+    void streamLevel(LevelStreamer &streamer);
+
+    // a NightBorne that chases the player, see setEnemyAnimations for its clips
+    Entity spawnEnemy(sf::Vector2f position);
+    void setEnemyAnimations(std::shared_ptr<const AnimationLibrary> animations);
+
+    // fan the per-entity systems out over jobs, null runs them serially;
+    // results are identical either way
+    void setJobSystem(JobSystem *jobs);
+
+    Ground &getGround();
+    const Registry &getRegistry() const;
+    Player &getPlayer();
+    const Player &getPlayer() const;
+    const sf::View &getCamera() const;
+    sf::Vector2f getPreviousCameraCenter() const;
+
+    // FNV-1a over every entity's movement and animation state and the
+    // camera; the same inputs from the same start give the same hash
+    std::uint64_t getStateHash() const;
+
+private:
+    void updateCamera(float deltaTime);
+    void setupLevel(const LevelInfo &info, const std::vector<LevelSpawn> &spawns);
+
+    Registry registry;
+    Ground ground;
+    Player player;
+
+    // Systems, run in this order every step
+    EnemyAiSystem enemyAi;
+    PhysicsSystem physics;
+    AnimationSystem animation;
+
+    // Camera
+    sf::View camera;
+    float cameraSmoothing;
+    sf::Vector2f previousCameraCenter;
+
+    // Map / tiles, taken from the loaded level
+    int mapWidth;
+    int mapHeight;
+    int tileSizeX;
+    int tileSizeY;
+
+    JobSystem *jobs;
+    LevelStreamer *streamer;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/ResourceManager.hpp"
+
+// Sound effects loaded up front, played by id so playing one never looks
+// anything up by name
+enum class SoundId : std::uint8_t
+{
+    SwordSlash,
+    Count
+};
+
+// Music and sound effects, all on the thread that calls it (Game's update
+// thread). Music streams through two sf::Music decks, decoded a chunk at a
+// time from the asset pack or the file, so a track change crossfades from
+// one deck to the other. Effects play on a fixed pool of voices sharing the
+// ResourceManager's decoded buffers; when every voice is busy the lowest
+// priority (then oldest) one is stolen, if it is not above the new sound.
+class AudioSystem
+{
+public:
+    // what play() goes by when it picks a voice
+    struct VoiceState
+    {
+        bool playing;     // playing or paused, anything but stopped
+        bool holdsBuffer; // already set to the new sound's buffer
+        int priority;
+        std::uint64_t startedAt; // play counter, lower is older
+    };
+
+private:
+    ResourceManager &m_resources;
+    std::array<SoundBufferHandle, static_cast<std::size_t>(SoundId::Count)> m_buffers;
+
+    // voices are built on it, sf::Sound needs a buffer from the start
+    sf::SoundBuffer m_silence;
+    std::vector<sf::Sound> m_voices; // sized once, never grows
+    std::vector<VoiceState> m_voiceStates; // one per voice
+    std::uint64_t m_playCount;
+    float m_soundVolume;
+
+    std::array<sf::Music, 2> m_decks;
+    std::size_t m_currentDeck;
+    std::string m_currentTrack;
+    float m_musicVolume;
+    float m_fadeDuration; // 0 when not fading
+    float m_fadeElapsed;
+    float m_fadeOutVolume; // the outgoing deck's volume when the fade began
+
+    bool openTrack(sf::Music &deck, const std::string &path);
+    void setDeckVolumes(float fade);
+
+public:
+    AudioSystem(ResourceManager &resources, std::size_t voiceCount = 16);
+
+    AudioSystem(const AudioSystem &) = delete;
+    AudioSystem &operator=(const AudioSystem &) = delete;
+
+    bool loadSound(SoundId id, const std::string &path);
+
+    // false if the sound is not loaded or every voice plays something of
+    // higher priority; allocates nothing
+    bool play(SoundId id, int priority = 0, float pitch = 1.f);
+
+    // fades the playing track out and path in over fadeSeconds (0 cuts);
+    // asking for the track already playing does nothing
+    bool playMusic(const std::string &path, float fadeSeconds = 0.f);
+    void stopMusic();
+
+    // advances a crossfade, call once per frame
+    void update(float deltaTime);
+
+    void setMusicVolume(float volume); // 0 to 100
+    void setSoundVolume(float volume);
+
+    std::size_t getVoiceCount() const;
+    std::size_t getPlayingVoiceCount() const;
+
+    // the voice a new sound of this priority takes: a free one holding its
+    // buffer, then any free one, then the lowest priority playing one (the
+    // oldest on a tie) unless that is above priority; -1 if there is none.
+    // Needs no audio device, fuzz_voices checks the order with it
+    static int chooseVoice(const std::vector<VoiceState> &voices, int priority);
+};
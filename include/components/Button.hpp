@@ -9,7 +9,7 @@ class Button
 {
 private:
     sf::RectangleShape m_shape;
-    sf::Font *m_font;
+    const sf::Font *m_font;
     std::optional<sf::Text> m_text;
 
     sf::Color m_normalColor;
@@ -28,7 +28,7 @@ public:
     Button(float x, float y, float width, float height);
 
     // Setup
-    void setFont(sf::Font &font);
+    void setFont(const sf::Font &font);
     void setText(const std::string &text);
     void setTextSize(unsigned int size);
     void setPosition(float x, float y);
@@ -45,6 +45,9 @@ public:
     void handleMouseMove(sf::Vector2f pos);
     bool handleMousePress(sf::Vector2f pos);
     void handleMouseRelease();
+    // keyboard focus shows the same as the mouse hovering
+    void setHovered(bool hovered);
+    void click();
 
     // Getters
     bool isMouseOver(sf::Vector2f mousePos) const;
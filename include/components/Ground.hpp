@@ -2,22 +2,106 @@
 
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include "physics/CollisionGrid.hpp"
+#include "core/ResourceManager.hpp"
+#include "level/Level.hpp"
 
 class Ground
 {
 private:
-    sf::Texture m_tileset;
-    std::vector<sf::Sprite> m_tiles;
-    std::vector<sf::FloatRect> m_collisionBoxes;
+    // tiles per chunk side, each chunk owns its own prebuilt geometry
+    static constexpr int CHUNK_SIZE = 16;
+
+    struct Tile
+    {
+        sf::Vector2f position;
+        sf::Vector2i tileIndex; // negative: collision only, never drawn
+        bool solid;
+    };
+
+    struct Chunk
+    {
+        std::vector<Tile> tiles;
+        sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+        bool dirty = false;
+
+        // the chunk's solid tiles merged, redone by the (const) lazy
+        // collision rebuild only when its tiles change; until then these are
+        // the boxes the grid holds for the chunk
+        mutable std::vector<sf::FloatRect> collisionBoxes;
+        mutable bool collisionDirty = false;
+    };
+
+public:
+    // A region's chunks built off the simulation thread (see LevelStreamer),
+    // ready to be swapped in by addRegion; ok is false when the region
+    // could not be read and must not be added
+    struct PreparedRegion
+    {
+        std::uint32_t index;
+        bool ok;
+        std::size_t tileCount;
+        std::vector<std::pair<std::int64_t, Chunk>> chunks;
+    };
+
+private:
+    TextureHandle m_tileset;
+    std::unordered_map<std::int64_t, Chunk> m_chunks;
     int m_tileWidth;
     int m_tileHeight;
+    std::size_t m_tileCount;
+
+    // the render thread draws while the simulation thread adds and removes
+    // chunks; it only holds this for the draw and the swap itself
+    std::mutex m_chunkMutex;
+
+    // streamed levels only: regions of the map and which are resident
+    LevelInfo m_streamedLevel;
+    std::vector<std::uint8_t> m_regionResident;
+
+    // merged collision rectangles of every chunk; the first query after an
+    // edit re-merges only the chunks listed in m_dirtyChunks
+    mutable CollisionGrid m_collisionGrid;
+    mutable std::vector<std::int64_t> m_dirtyChunks;
+    mutable bool m_collisionDirty;
+
+    sf::Vector2i chunkCoordOf(sf::Vector2f position) const;
+    static std::int64_t chunkKey(int chunkX, int chunkY);
+    void rebuildVertices(Chunk &chunk) const;
+    void markCollisionDirty(std::int64_t key, Chunk &chunk);
+    void rebuildCollision() const;
 
 public:
-    Ground(const std::string &tilesetPath, int tileW, int tileH);
+    Ground(int tileW, int tileH);
+    void setTileset(TextureHandle tileset);
     void addTile(float x, float y, int tileIndexX, int tileIndexY);
+    // replaces every tile, sized up front so no chunk ever regrows
+    void loadLevel(const Level &level);
+    bool removeTile(float x, float y);
     void createHorizontalPlatform(float startX, float y, int length, int tileIndexX, int tileIndexY);
     void createVerticalPlatform(float x, float startY, int length, int tileIndexX, int tileIndexY);
-    void draw(sf::RenderWindow &window);
+    void draw(sf::RenderWindow &window, const sf::View &view);
+    void updateCollision() const;
     const std::vector<sf::FloatRect> &getCollisionBoxes() const;
+    void queryRegion(const sf::FloatRect &region, std::vector<sf::FloatRect> &out) const;
     void clear();
-};
\ No newline at end of file
+
+    // Streaming: empties the ground and expects the level's regions to come
+    // in through addRegion. False if its regions do not line up with chunks.
+    bool beginStreaming(const LevelInfo &level);
+    // safe on any thread while the streamed level stays the same
+    PreparedRegion prepareRegion(const LevelRegion &region) const;
+    void addRegion(PreparedRegion &&region);
+    void removeRegion(std::uint32_t index);
+    // false while part of area belongs to a region that is not resident;
+    // always true for ground that is not streamed
+    bool isLoaded(const sf::FloatRect &area) const;
+
+    std::size_t getTileCount() const;
+    // approximate memory held by tiles and their vertices
+    std::size_t getResidentBytes() const;
+};
@@ -1,94 +1,90 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <iostream>
 #include <memory>
-#include <optional>
+#include "ecs/Registry.hpp"
+#include "input/PlayerInput.hpp"
+#include "graphics/AnimationClip.hpp"
 
 enum class AnimationState
 {
     Idle,
     Walking,
     Jumping,
-    Attacking
+    Attacking,
+    Count
 };
 
+// The player is one entity in the world's Registry. Transform, velocity,
+// collider and animation live in the component pools and are advanced by
+// the systems; this class only keeps the controller state (jumping,
+// attacking) and turns input into velocity and clip changes.
 class Player
 {
 private:
-    sf::Texture m_idleTexture;
-    sf::Texture m_walkTexture;
-    sf::Texture m_jumpTexture;
-    sf::Texture m_attackTexture;
-    sf::Sprite m_sprite;
-    sf::Vector2f m_position;
-    sf::Vector2f m_velocity;
-    sf::FloatRect m_collisionBox;
+    // every knight sheet is laid out in 128x64 frames (see knight/_Info.txt)
+    static constexpr int FRAME_WIDTH = 128;
+    static constexpr int FRAME_HEIGHT = 64;
+
+    // how many steps (at 120 Hz) a press waits to be acted on: a jump
+    // pressed just before landing, an attack pressed during the cooldown
+    static constexpr std::uint16_t JUMP_BUFFER_STEPS = 12;
+    static constexpr std::uint16_t ATTACK_BUFFER_STEPS = 24;
+
+    Registry &m_registry;
+    Entity m_entity;
+
+    std::shared_ptr<const AnimationLibrary> m_animations;
+    // clip per AnimationState, indexed by the state value
+    std::array<const AnimationClip *, static_cast<std::size_t>(AnimationState::Count)> m_clips;
 
     float m_speed;
     float m_jumpForce;
-    float m_gravity;
-    bool m_isOnGround;
     bool m_isJumping;
-    bool m_isFacingRight;
+    InputBuffer m_inputBuffer;
 
     // animation
     AnimationState m_currentState;
     AnimationState m_previousState;
-    sf::IntRect m_currentFrame;
-    int m_currentFrameIndex;
-    float m_animationTimer;
-    float m_idleAnimSpeed;
-    float m_walkAnimSpeed;
-    float m_attackAnimSpeed;
     bool m_isAttacking;
     float m_attackCooldown;
     float m_attackCooldownTimer;
 
     sf::FloatRect m_attackHitbox;
     bool m_attackHitboxActive;
+    bool m_attackStarted; // this step, for sounds and effects outside the world
 
-    struct AnimationConfig
-    {
-        int m_frameCount;
-        int m_columns;
-        int m_rows;
-    };
-
-    AnimationConfig m_idleAnim;
-    AnimationConfig m_walkAnim;
-    AnimationConfig m_jumpAnim;
-    AnimationConfig m_attackAnim;
-
-    int m_currentFrameWidth;
-    int m_currentFrameHeight;
+    std::size_t index() const;
+    const AnimationClip *clipFor(AnimationState state) const;
+    bool canAttack() const;
 
 public:
-    Player(const std::string &idleTexturePath,
-           const std::string &walkTexturePath,
-           const std::string &jumpTexturePath,
-           const std::string &attackTexturePath,
-           float positionX,
-           float positionY);
-    void handleInput();
+    Player(Registry &registry, float positionX, float positionY);
+    Player(const Player &) = delete;
+    Player &operator=(const Player &) = delete;
+
+    void setAnimations(std::shared_ptr<const AnimationLibrary> animations);
+    void handleInput(const PlayerInput &input);
     void attack();
-    void updateAnimation(float deltaTime);
-    void applyPhysics(float deltaTime, const std::vector<sf::FloatRect> &groundBoxes);
-    void update(float deltaTime, const std::vector<sf::FloatRect> &groundBoxes);
-    void draw(sf::RenderWindow &window);
-    bool isFacingRight();
+    // after the physics and animation systems ran for this step
+    void update(float deltaTime);
+    Entity getEntity() const;
+    bool isFacingRight() const;
     sf::Vector2f getPosition() const;
+    sf::Vector2f getVelocity() const;
+    bool isOnGround() const;
+    sf::Vector2f getRenderPosition(float alpha) const;
     sf::FloatRect getCollisionHitbox() const;
     sf::FloatRect getAttackHitbox() const;
-    void drawAttackHitbox(sf::RenderWindow &window);
     bool isAttackHitboxActive() const;
-    void setAttackAnimation(int columns, int rows, int frameCount);
-    void setAttackSpeed(float speed);
+    // a swing began during the last step
+    bool hasAttackStarted() const;
     void setAttackCooldown(float cooldown);
     void updateAttackHitbox();
-    void setIdleAnimation(int columns, int rows, int frameCount);
-    void setWalkAnimation(int columns, int rows, int frameCount);
-    void setJumpAnimation(int columns, int rows, int frameCount);
     void setJumpForce(float force);
     void setGravity(float grav);
-};
\ No newline at end of file
+    // teleport, without interpolating from the old position
+    void setPosition(sf::Vector2f position);
+};
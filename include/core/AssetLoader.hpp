@@ -0,0 +1,59 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/ResourceManager.hpp"
+
+// Loads textures in the background. Worker threads read and decode image
+// files into sf::Image, update() then uploads finished images to the GPU on
+// the thread that owns the window and stores them in the ResourceManager.
+// Images come from the manager's asset pack when one is mounted, so mount it
+// before queueing anything.
+class AssetLoader
+{
+private:
+    struct DecodedImage
+    {
+        std::string path;
+        sf::Image image;
+        bool loaded;
+    };
+
+    ResourceManager &m_resources;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorkers;
+    std::deque<std::string> m_pending;
+    std::deque<DecodedImage> m_decoded;
+    bool m_stopping;
+
+    // only touched on the window thread
+    std::size_t m_queuedCount;
+    std::size_t m_finishedCount;
+
+    void workerLoop();
+
+public:
+    // threadCount 0 picks one worker per spare hardware thread
+    explicit AssetLoader(ResourceManager &resources, unsigned int threadCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader &) = delete;
+    AssetLoader &operator=(const AssetLoader &) = delete;
+
+    // queueTexture, update and the progress queries belong to the window thread
+    void queueTexture(const std::string &path);
+
+    // call once per frame, uploads at most maxUploads decoded textures
+    void update(std::size_t maxUploads = 4);
+
+    float getProgress() const;
+    bool isDone() const;
+};
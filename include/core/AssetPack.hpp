@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+
+// Pack file built by tools/asset_packer.cpp (little-endian):
+//   header  magic "IANHPACK", u32 version, u32 entryCount
+//   toc     per entry: u64 offset, u64 size, u16 length + path ("assets/...")
+//   blobs   file contents, each starting on a BLOB_ALIGNMENT boundary
+namespace PackFormat
+{
+    const char MAGIC[8] = {'I', 'A', 'N', 'H', 'P', 'A', 'C', 'K'};
+    const std::uint32_t VERSION = 1;
+    const std::uint64_t BLOB_ALIGNMENT = 64;
+}
+
+// Read-only view of a pack file mapped into memory. Blobs point straight
+// into the mapping, so loaders can decode from them without copying.
+class AssetPack
+{
+public:
+    struct Blob
+    {
+        const void *data;
+        std::size_t size;
+    };
+
+private:
+    const unsigned char *m_data;
+    std::size_t m_size;
+    std::unordered_map<std::string, Blob> m_entries;
+
+#ifdef _WIN32
+    void *m_file;
+    void *m_mapping;
+#else
+    int m_file;
+#endif
+
+    bool readTableOfContents();
+
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const;
+
+    // path as used in Constants.hpp, e.g. "assets/fonts/..."
+    std::optional<Blob> find(const std::string &path) const;
+    std::size_t getEntryCount() const;
+};
+
+// Read-only streambuf over a blob, so text and binary readers can parse
+// straight from the mapping: std::istream in(&buffer)
+class BlobStreamBuffer : public std::streambuf
+{
+public:
+    explicit BlobStreamBuffer(const AssetPack::Blob &blob)
+    {
+        // the get area is never written through
+        char *begin = const_cast<char *>(static_cast<const char *>(blob.data));
+        setg(begin, begin, begin + blob.size);
+    }
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 64-bit FNV-1a, for the determinism checks: cheap, and the same on every
+// platform for the same bytes
+namespace Hash
+{
+    const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    // folds size bytes at data into hash, which starts at FNV_OFFSET
+    inline void addBytes(std::uint64_t &hash, const void *data, std::size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing scheduler for data-parallel loops. parallelFor() splits an
+// index range into chunks spread over per-thread queues; each thread drains
+// its own queue and then steals from the others. The calling thread joins in
+// and the call returns once every chunk has run.
+//
+// Every index is visited exactly once, so a body that only writes the
+// entries it is given gives the same result as a serial loop no matter how
+// chunks land on threads. parallelFor must only be called from one thread
+// at a time and not from inside a body.
+class JobSystem
+{
+private:
+    using Invoke = void (*)(const void *body, std::size_t begin, std::size_t end, unsigned int thread);
+
+    struct Job
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        std::size_t head = 0; // thieves take from the front, the owner from the back
+    };
+
+    std::vector<std::thread> m_workers;
+    std::vector<Queue> m_queues; // index 0 belongs to the calling thread
+
+    // the loop currently running, set before any of its jobs are queued
+    Invoke m_invoke;
+    const void *m_body;
+    std::atomic<std::size_t> m_remainingJobs;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeWorkers;
+    std::atomic<std::size_t> m_queuedJobs;
+    bool m_stopping;
+
+    void workerLoop(unsigned int thread);
+    bool popJob(unsigned int thread, Job &job);
+    bool stealJob(unsigned int thread, Job &job);
+    void runJob(const Job &job, unsigned int thread);
+    void run(std::size_t count, std::size_t grain, Invoke invoke, const void *body);
+
+public:
+    // threadCount counts the calling thread, 0 uses every hardware thread
+    explicit JobSystem(unsigned int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    unsigned int getThreadCount() const;
+
+    // calls body(begin, end, thread) over [0, count) in chunks of at most
+    // grain indices; thread is in [0, getThreadCount()) for per-thread scratch
+    template <typename Body>
+    void parallelFor(std::size_t count, std::size_t grain, const Body &body)
+    {
+        run(count, grain, [](const void *context, std::size_t begin, std::size_t end, unsigned int thread)
+            { (*static_cast<const Body *>(context))(begin, end, thread); }, &body);
+    }
+};
+
+// parallelFor on jobs, or a plain serial call on the calling thread when
+// there is no job system
+template <typename Body>
+void parallelFor(JobSystem *jobs, std::size_t count, std::size_t grain, const Body &body)
+{
+    if (jobs)
+    {
+        jobs->parallelFor(count, grain, body);
+    }
+    else if (count > 0)
+    {
+        body(0, count, 0);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+// Reading and writing the little-endian integers and floats of the binary
+// formats (asset pack, level, atlas index, input recording). Byte by byte,
+// so it gives the same file on any host and never reads unaligned.
+namespace LittleEndian
+{
+    inline std::uint16_t readU16(const unsigned char *bytes)
+    {
+        return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+    }
+
+    inline std::uint32_t readU32(const unsigned char *bytes)
+    {
+        return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+               (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+    }
+
+    inline std::uint64_t readU64(const unsigned char *bytes)
+    {
+        return static_cast<std::uint64_t>(readU32(bytes)) | (static_cast<std::uint64_t>(readU32(bytes + 4)) << 32);
+    }
+
+    inline float readF32(const unsigned char *bytes)
+    {
+        std::uint32_t bits = readU32(bytes);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // stream versions, false once the stream runs out
+    inline bool readU16(std::istream &in, std::uint16_t &value)
+    {
+        unsigned char bytes[2];
+        if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes)))
+        {
+            return false;
+        }
+        value = readU16(bytes);
+        return true;
+    }
+
+    inline bool readU32(std::istream &in, std::uint32_t &value)
+    {
+        unsigned char bytes[4];
+        if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes)))
+        {
+            return false;
+        }
+        value = readU32(bytes);
+        return true;
+    }
+
+    inline void writeU16(std::ostream &out, std::uint16_t value)
+    {
+        unsigned char bytes[2] = {static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8)};
+        out.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+    }
+
+    inline void writeU32(std::ostream &out, std::uint32_t value)
+    {
+        unsigned char bytes[4] = {static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+                                  static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)};
+        out.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+    }
+
+    inline void writeU64(std::ostream &out, std::uint64_t value)
+    {
+        writeU32(out, static_cast<std::uint32_t>(value & 0xFFFFFFFFu));
+        writeU32(out, static_cast<std::uint32_t>(value >> 32));
+    }
+
+    inline void writeF32(std::ostream &out, float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(out, bits);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Timed sections of a frame, see PROFILE_ZONE
+enum class ProfileZone : std::uint8_t
+{
+    Events,     // Game::processEvents
+    Input,      // Player::handleInput
+    Physics,    // PhysicsSystem::update
+    Animation,  // AnimationSystem::update
+    GroundDraw, // Ground::draw
+    Particles,  // ParticlePool::update, both pools
+    Display,    // window.display(), vsync wait included
+    Count
+};
+
+// Keeps the last HISTORY_SIZE timings of every zone, and of whole rendered
+// frames, in ring buffers for the overlay (see graphics/ProfilerOverlay.hpp).
+// Zones are recorded on both the simulation and the render thread, each zone
+// always on the same one; recording never locks or allocates.
+namespace Profiler
+{
+    const std::size_t HISTORY_SIZE = 240;
+
+    struct Summary
+    {
+        float last; // milliseconds
+        float p50;
+        float p99;
+    };
+
+    const char *getZoneName(ProfileZone zone);
+
+    void record(ProfileZone zone, float milliseconds);
+    // render thread, once per frame
+    void recordFrame(float milliseconds);
+
+    Summary summarize(ProfileZone zone);
+    Summary summarizeFrames();
+    // oldest first
+    void copyFrameTimes(std::vector<float> &out);
+}
+
+// records its own lifetime into a zone, and into the trace while tracing
+// is on (see core/Tracer.hpp)
+class ProfileScope
+{
+private:
+    ProfileZone m_zone;
+    bool m_traced;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    explicit ProfileScope(ProfileZone zone);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// times the rest of the enclosing block, e.g. PROFILE_ZONE(ProfileZone::Physics);
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+// Per-frame render counters. Game resets them at the start of every frame,
+// every draw call made by the world reports itself through addDrawCall().
+namespace RenderStats
+{
+    extern std::size_t drawCalls;
+    extern std::size_t vertices;
+
+    void reset();
+    void addDrawCall(std::size_t vertexCount);
+}
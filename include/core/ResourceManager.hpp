@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include "core/AssetPack.hpp"
+
+// Cheap, reference-counted handles to shared assets. Copying a handle never
+// touches the asset, an empty handle means the asset failed to load.
+using TextureHandle = std::shared_ptr<const sf::Texture>;
+using FontHandle = std::shared_ptr<const sf::Font>;
+using SoundBufferHandle = std::shared_ptr<const sf::SoundBuffer>;
+
+// Loads every asset once, keyed by its path (see Paths in Constants.hpp),
+// and hands out handles to the cached copy. With a pack mounted, assets are
+// decoded straight from the mapped pack, otherwise from loose files.
+class ResourceManager
+{
+private:
+    // declared first so the mapping outlives the fonts streaming from it
+    AssetPack m_pack;
+    std::unordered_map<std::string, std::shared_ptr<sf::Texture>> m_textures;
+    std::unordered_map<std::string, std::shared_ptr<sf::Font>> m_fonts;
+    std::unordered_map<std::string, std::size_t> m_fontFileSizes;
+    std::unordered_map<std::string, std::shared_ptr<sf::SoundBuffer>> m_soundBuffers;
+
+public:
+    // mount before loading anything, lookups fall back to loose files if this fails
+    bool mountPack(const std::string &path);
+    bool hasPack() const;
+    // safe to call from loader threads once the pack is mounted
+    std::optional<AssetPack::Blob> findInPack(const std::string &path) const;
+
+    TextureHandle getTexture(const std::string &path);
+    // upload an already decoded image and cache it under path (see AssetLoader)
+    TextureHandle addTexture(const std::string &path, const sf::Image &image);
+    FontHandle getFont(const std::string &path);
+    // decoded to samples once, every sound playing it shares the buffer
+    SoundBufferHandle getSoundBuffer(const std::string &path);
+
+    // handles are read-only, sampling state is set on the cached copy every
+    // handle shares; false if path is not loaded
+    bool setTextureRepeated(const std::string &path, bool repeated);
+
+    // drop cached assets nobody holds a handle to anymore
+    void releaseUnused();
+
+    std::size_t getTextureCount() const;
+    std::size_t getFontCount() const;
+    std::size_t getSoundBufferCount() const;
+
+    // approximate memory held by cached assets (RGBA texels, font files,
+    // 16-bit samples)
+    std::size_t getResidentBytes() const;
+    void printReport(std::ostream &out) const;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+// Timeline capture in the Chrome trace_event JSON format, for chrome://tracing
+// or ui.perfetto.dev. Every thread records begin/end events into its own
+// fixed-size buffer with no locks; writeJson merges them after the capture.
+// Event names are kept as pointers, so they must be string literals.
+namespace Tracer
+{
+    // events per thread and capture, later ones are dropped
+    const std::size_t THREAD_CAPACITY = 1 << 16;
+
+    extern std::atomic<bool> enabled;
+
+    // the one check a zone makes while tracing is off
+    inline bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // names the calling thread in the trace; call at thread start
+    void setThreadName(const char *name);
+
+    // start discards the previous capture
+    void start();
+    void stop();
+
+    void begin(const char *name);
+    void end(const char *name);
+
+    // the last capture, best after stop(); false if the file can't be written
+    bool writeJson(const std::string &path);
+}
+
+// traces its own lifetime while tracing is on
+class TraceScope
+{
+private:
+    const char *m_name;
+    bool m_traced;
+
+public:
+    explicit TraceScope(const char *name)
+        : m_name(name),
+          m_traced(Tracer::isEnabled())
+    {
+        if (m_traced)
+        {
+            Tracer::begin(m_name);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_traced)
+        {
+            Tracer::end(m_name);
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// traces the rest of the enclosing block, e.g. TRACE_ZONE("world step");
+#define TRACE_ZONE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
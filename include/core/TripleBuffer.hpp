@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single producer / single consumer handoff of the latest value.
+// The writer fills back() and publishes it, the reader picks up the newest
+// published value with update() and reads front(). Neither side ever waits,
+// values the reader was too slow to see are simply skipped.
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4; // middle holds an unread value
+
+    T m_slots[3];
+    std::atomic<std::uint8_t> m_middle;
+    std::uint8_t m_back;  // writer only
+    std::uint8_t m_front; // reader only
+
+public:
+    TripleBuffer()
+        : m_middle(1),
+          m_back(0),
+          m_front(2)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // writer side; holds whatever was published two values ago, so it has to
+    // be overwritten completely
+    T &back()
+    {
+        return m_slots[m_back];
+    }
+
+    void publish()
+    {
+        std::uint8_t previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    // reader side; returns false if nothing new was published since last time
+    bool update()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH))
+        {
+            return false;
+        }
+
+        std::uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T &front() const
+    {
+        return m_slots[m_front];
+    }
+};
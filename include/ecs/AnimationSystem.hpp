@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include "core/JobSystem.hpp"
+#include "ecs/Registry.hpp"
+
+// Advances every entity's clip. Frame events and the finished flag are left
+// in the AnimationPool for gameplay code to read after the update.
+class AnimationSystem
+{
+private:
+    static void updateRange(AnimationPool &pool, float deltaTime, std::size_t begin, std::size_t end);
+
+public:
+    // jobs may be null to run on the calling thread
+    void update(Registry &registry, float deltaTime, JobSystem *jobs);
+
+    // switch an entity to clip, restarting it from the first frame
+    static void play(Registry &registry, std::size_t index, const AnimationClip *clip);
+};
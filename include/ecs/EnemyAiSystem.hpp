@@ -0,0 +1,26 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include "core/JobSystem.hpp"
+#include "ecs/Registry.hpp"
+
+// Walks Chase entities toward a target once it is within their aggro range
+// and picks their idle or run clip to match.
+class EnemyAiSystem
+{
+private:
+    std::shared_ptr<const AnimationLibrary> m_animations;
+    const AnimationClip *m_idleClip;
+    const AnimationClip *m_runClip;
+
+    void updateRange(Registry &registry, sf::Vector2f target, std::size_t begin, std::size_t end) const;
+
+public:
+    EnemyAiSystem();
+
+    // without clips enemies still move, they just do not animate
+    void setAnimations(std::shared_ptr<const AnimationLibrary> animations);
+    // jobs may be null to run on the calling thread
+    void update(Registry &registry, sf::Vector2f target, JobSystem *jobs);
+};
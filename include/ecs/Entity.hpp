@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+// Handle to an entity in a Registry. The generation tells a stale handle
+// apart from a new entity that reused the same slot.
+struct Entity
+{
+    std::uint32_t slot;
+    std::uint32_t generation;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "components/Ground.hpp"
+#include "core/JobSystem.hpp"
+#include "ecs/Registry.hpp"
+
+// Gravity, movement and ground collision for every entity with a collider.
+// Each step's motion is swept against the ground boxes along its whole path
+// (sweepAndSlide): the body stops at the earliest contact and slides the
+// rest along that face, a few passes at most, so fast bodies never skip
+// thin ground. Touching a top face is what counts as landing.
+// Entities never touch each other here, so ranges of them run in parallel.
+class PhysicsSystem
+{
+private:
+    // ground boxes near the current entity, one list per job thread (on its
+    // own cache line) and reused to avoid reallocating
+    struct alignas(64) Scratch
+    {
+        std::vector<sf::FloatRect> nearbyBoxes;
+    };
+    std::vector<Scratch> m_scratch;
+
+    void updateRange(Registry &registry, const Ground &ground, float deltaTime,
+                     std::size_t begin, std::size_t end, std::vector<sf::FloatRect> &nearbyBoxes) const;
+
+public:
+    // jobs may be null to run on the calling thread
+    void update(Registry &registry, const Ground &ground, float deltaTime, JobSystem *jobs);
+};
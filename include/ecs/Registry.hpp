@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ecs/Entity.hpp"
+#include "graphics/AnimationClip.hpp"
+
+// Component pools, stored as structure of arrays. Every live entity owns the
+// same dense index in every column, so systems walk them front to back.
+struct TransformPool
+{
+    std::vector<sf::Vector2f> position;
+    std::vector<sf::Vector2f> previousPosition; // for render interpolation
+};
+
+struct VelocityPool
+{
+    std::vector<sf::Vector2f> velocity;
+    std::vector<float> gravity;
+};
+
+struct ColliderPool
+{
+    std::vector<sf::FloatRect> localBox; // relative to the entity position
+    std::vector<std::uint8_t> onGround;
+};
+
+struct AnimationPool
+{
+    std::vector<const AnimationClip *> clip;
+    std::vector<std::uint32_t> frame;
+    std::vector<float> timer;
+    std::vector<std::uint32_t> events;     // AnimationEvent flags of the current frame
+    std::vector<std::uint8_t> finished;    // a one-shot clip ended this step
+    std::vector<std::uint8_t> facingRight;
+};
+
+enum class AiKind : std::uint8_t
+{
+    None, // driven from outside, e.g. the player
+    Chase
+};
+
+struct AiPool
+{
+    std::vector<AiKind> kind;
+    std::vector<float> speed;
+    std::vector<float> aggroRange;
+};
+
+// Owns every actor of a world. Destroying swaps the last entity into the
+// freed index, so dense indices are only stable until the next destroy().
+class Registry
+{
+private:
+    std::vector<Entity> m_entities;         // dense index -> handle
+    std::vector<std::uint32_t> m_denseIndex; // slot -> dense index
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint32_t> m_freeSlots;
+
+    template <typename Visitor>
+    void forEachColumn(Visitor &&visit)
+    {
+        visit(transforms.position);
+        visit(transforms.previousPosition);
+        visit(velocities.velocity);
+        visit(velocities.gravity);
+        visit(colliders.localBox);
+        visit(colliders.onGround);
+        visit(animations.clip);
+        visit(animations.frame);
+        visit(animations.timer);
+        visit(animations.events);
+        visit(animations.finished);
+        visit(animations.facingRight);
+        visit(ai.kind);
+        visit(ai.speed);
+        visit(ai.aggroRange);
+    }
+
+public:
+    TransformPool transforms;
+    VelocityPool velocities;
+    ColliderPool colliders;
+    AnimationPool animations;
+    AiPool ai;
+
+    // new entities stand still at position, with no collider, clip or AI
+    Entity create(sf::Vector2f position);
+    void destroy(Entity entity);
+    bool isAlive(Entity entity) const;
+
+    std::size_t indexOf(Entity entity) const;
+    Entity entityAt(std::size_t index) const;
+    std::size_t size() const;
+    void reserve(std::size_t count);
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "ecs/Registry.hpp"
+#include "graphics/RenderSnapshot.hpp"
+#include "graphics/SpriteAtlas.hpp"
+
+// Draws animated entities as atlas quads, batched into one vertex array and
+// one draw call per atlas page. capture() runs on the simulation thread and
+// turns the registry into SpriteInstances for a RenderSnapshot, draw() runs
+// on the render thread. Clips must be bound to the same atlas (see
+// AnimationLibrary::bind).
+class ActorRenderer
+{
+private:
+    std::shared_ptr<const SpriteAtlas> m_atlas;
+    // one batch per atlas page, rebuilt every frame but never shrunk
+    std::vector<sf::VertexArray> m_batches;
+
+public:
+    // set before the first capture, the atlas is shared read-only by both threads
+    void setAtlas(std::shared_ptr<const SpriteAtlas> atlas);
+
+    // appends every animated entity overlapping region to out
+    void capture(const Registry &registry, const sf::FloatRect &region, std::vector<SpriteInstance> &out) const;
+
+    // alpha interpolates between the previous and current simulation steps
+    void draw(sf::RenderWindow &window, const sf::View &view, const std::vector<SpriteInstance> &sprites, float alpha);
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/ResourceManager.hpp"
+#include "graphics/SpriteAtlas.hpp"
+
+// Gameplay events a clip can mark on its frames, as bit flags
+namespace AnimationEvent
+{
+    const std::uint32_t HITBOX = 1u << 0;
+}
+
+struct AnimationFrame
+{
+    std::uint32_t cell;       // frame of the clip's atlas sequence
+    std::uint32_t atlasFrame; // filled in by AnimationLibrary::bind
+    float duration;
+    std::uint32_t events;
+};
+
+struct AnimationClip
+{
+    std::string sequence;
+    bool loop;
+    std::vector<AnimationFrame> frames;
+};
+
+// Named clips loaded from a clip file (see assets/animations/knight.anim).
+// Timing and events are plain data, so headless worlds can play clips
+// without an atlas; bind() only resolves the frames for drawing.
+class AnimationLibrary
+{
+private:
+    std::unordered_map<std::string, AnimationClip> m_clips;
+    bool m_bound;
+
+    bool readClips(std::istream &in, const std::string &path);
+
+public:
+    AnimationLibrary();
+
+    // read from the resources' asset pack when it has the file
+    bool loadFromFile(const std::string &path, const ResourceManager &resources);
+
+    // resolve every frame to its atlas frame, fails if a sequence is missing
+    bool bind(const SpriteAtlas &atlas);
+
+    // nullptr if there is no clip with that name
+    const AnimationClip *findClip(const std::string &name) const;
+    bool isBound() const;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+struct PointLight
+{
+    sf::Vector2f position;
+    float radius;
+    sf::Color color; // brighter colours light more, white is full strength
+};
+
+// Night lighting. Every frame the map is cleared to the ambient colour and
+// the lights in view are added onto it, all of them as one batch of
+// falloff quads with additive blending, into an off-screen texture smaller
+// than the screen by the resolution scale. The map is then stretched over
+// the view and multiplied onto what is already drawn in a single quad.
+// The off-screen texture is (re)built by draw(), on the thread that renders.
+class LightMap
+{
+private:
+    sf::RenderTexture m_target;
+    sf::Texture m_falloff;
+    std::vector<sf::Vertex> m_vertices; // reused, never shrunk
+
+    sf::Vector2u m_screenSize;
+    float m_resolutionScale;
+    sf::Vector2u m_targetSize; // what m_target was built at
+    sf::Color m_ambient;
+    std::size_t m_visibleLights;
+
+    bool prepare();
+
+public:
+    LightMap();
+
+    // screenSize is the area the map covers on screen, usually the window;
+    // scale is the light map's fraction of it per side, (0, 1]
+    void setScreenSize(sf::Vector2u screenSize);
+    void setResolutionScale(float scale);
+    float getResolutionScale() const;
+    void setAmbient(sf::Color ambient);
+
+    // lights outside view are skipped
+    void draw(sf::RenderTarget &target, const sf::View &view, const std::vector<PointLight> &lights);
+
+    std::size_t getVisibleLightCount() const;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+#include "core/ResourceManager.hpp"
+
+// Background images behind the world, back to front. Each layer is a single
+// quad over the view whose texture coordinates scroll with the camera, the
+// texture repeats (see ResourceManager::setTextureRepeated) so one draw call
+// per layer covers any map width.
+class ParallaxBackground
+{
+private:
+    struct Layer
+    {
+        TextureHandle texture;
+        sf::Vector2f scrollFactor;
+    };
+
+    std::vector<Layer> m_layers;
+
+public:
+    // scrollFactor 0 stays put on screen, 1 moves with the world; a layer is
+    // scaled to the view height and repeats sideways (and vertically when it
+    // scrolls that way too)
+    void addLayer(TextureHandle texture, sf::Vector2f scrollFactor);
+    void clear();
+
+    std::size_t getLayerCount() const;
+
+    void draw(sf::RenderTarget &target, const sf::View &view) const;
+};
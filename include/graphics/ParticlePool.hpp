@@ -0,0 +1,107 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "core/ResourceManager.hpp"
+
+// How an emitter's particles start out; size and colour go from start to end
+// over each particle's life
+struct ParticleSettings
+{
+    float rate = 0.f; // particles per second while the emitter is active
+    float lifetime = 1.f;
+    float lifetimeJitter = 0.f; // lifetime +- this
+    sf::Vector2f velocity;
+    sf::Vector2f velocityJitter; // each axis +- this
+    float gravity = 0.f;         // px/s^2 down, negative rises
+    float startSize = 16.f;
+    float endSize = 16.f;
+    sf::Color startColor = sf::Color::White;
+    sf::Color endColor = sf::Color::Transparent;
+};
+
+// Visual-only particles with a fixed capacity, kept as structure of arrays
+// allocated once up front. update() runs plain loops over float arrays the
+// compiler can vectorize and swaps dead particles out with the last live
+// one. The whole pool is one vertex array drawn with one texture in a single
+// call; the texture can be a flipbook of frames played over each life.
+class ParticlePool
+{
+private:
+    // size and colour at one point of a life, looked up by the vertex build
+    // instead of blended per particle
+    struct LifeStep
+    {
+        float halfSize;
+        sf::Color color;
+    };
+    static constexpr std::size_t LIFE_STEPS = 64;
+
+    struct Emitter
+    {
+        ParticleSettings settings;
+        sf::FloatRect area; // spawn anywhere inside, zero size is a point
+        bool active;
+        float pending; // fraction of a particle carried to the next update
+        std::array<LifeStep, LIFE_STEPS> life;
+    };
+
+    std::size_t m_capacity;
+    std::size_t m_count;
+
+    // one entry per live particle, index < m_count
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_gravity;
+    std::vector<float> m_age;
+    std::vector<float> m_inverseLifetime;
+    std::vector<std::uint16_t> m_emitter;
+
+    std::vector<Emitter> m_emitters;
+    std::minstd_rand m_random;
+
+    TextureHandle m_texture;
+    sf::Vector2u m_frameGrid; // flipbook columns and rows
+    unsigned int m_frameCount;
+    std::vector<sf::Vector2f> m_frameCorners; // each frame's top left texel
+    sf::Vector2f m_frameSize;
+    // six per particle for the whole capacity, only the first
+    // m_vertexCount are drawn
+    std::vector<sf::Vertex> m_vertices;
+    std::size_t m_vertexCount;
+
+    float jitter(float range);
+    void spawn(std::uint16_t emitter);
+
+public:
+    explicit ParticlePool(std::size_t capacity);
+
+    // frameCount 0 plays every cell of the columns x rows grid
+    void setTexture(TextureHandle texture, sf::Vector2u frameGrid = {1, 1}, unsigned int frameCount = 0);
+
+    std::size_t addEmitter(const ParticleSettings &settings, const sf::FloatRect &area, bool active = true);
+    void setEmitterArea(std::size_t emitter, const sf::FloatRect &area);
+    void setEmitterActive(std::size_t emitter, bool active);
+    // kills every particle too, they refer to their emitter's settings
+    void clearEmitters();
+
+    // spawns count particles from emitter at once, active or not
+    void burst(std::size_t emitter, std::size_t count);
+
+    // spawns from the active emitters, then moves and ages every particle;
+    // spawns past the capacity are dropped
+    void update(float deltaTime);
+
+    // fills the vertex array with the particles overlapping view
+    void buildVertices(const sf::View &view);
+    void draw(sf::RenderTarget &target, const sf::View &view);
+
+    std::size_t getCount() const;
+    std::size_t getCapacity() const;
+};
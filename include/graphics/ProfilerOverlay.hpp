@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <vector>
+#include "core/Profiler.hpp"
+#include "core/ResourceManager.hpp"
+#include "level/LevelStreamer.hpp"
+
+// Debug overlay in the top-left corner of the window: a graph of recent
+// frame times, p50/p99 of every profiler zone, the world's draw calls and
+// what the level streamer holds. Render thread only.
+class ProfilerOverlay
+{
+private:
+    FontHandle m_font;
+    std::optional<sf::Text> m_text;
+    sf::RectangleShape m_background;
+
+    // one bar per frame in the profiler history, and the 120/60/30 fps lines
+    sf::VertexArray m_graph{sf::PrimitiveType::Triangles};
+    sf::VertexArray m_guides{sf::PrimitiveType::Lines};
+    std::vector<float> m_frameTimes;
+
+    // the text is rebuilt a few times a second, so it stays readable
+    sf::Clock m_refreshClock;
+    bool m_hasText;
+
+    void refreshText(std::size_t drawCalls, std::size_t vertices, const StreamingStats &streaming);
+    void rebuildGraph(sf::Vector2f origin);
+
+public:
+    ProfilerOverlay();
+
+    bool setFont(FontHandle font);
+
+    // drawCalls and vertices are the frame's counts before the overlay
+    // draws itself; leaves the window on its default view
+    void draw(sf::RenderWindow &window, std::size_t drawCalls, std::size_t vertices, const StreamingStats &streaming);
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "level/LevelStreamer.hpp"
+
+// One atlas quad, centred on the entity position
+struct SpriteInstance
+{
+    sf::Vector2f previousPosition;
+    sf::Vector2f position;
+    sf::IntRect textureRect;
+    std::uint16_t page;
+    bool flipped;
+};
+
+// Everything the render thread needs to draw one simulation state. Built on
+// the simulation thread after each batch of steps and handed over through a
+// TripleBuffer, so the renderer never reads the live World.
+struct RenderSnapshot
+{
+    bool showWorld = false; // otherwise the menu is drawn
+
+    sf::Vector2f previousCameraCenter;
+    sf::Vector2f cameraCenter;
+    sf::Vector2f cameraSize;
+
+    std::vector<SpriteInstance> sprites;
+
+    // debug overlays, at the player's current position
+    sf::Vector2f playerPreviousPosition;
+    sf::Vector2f playerPosition;
+    sf::FloatRect playerCollisionBox;
+    bool attackHitboxActive = false;
+    sf::FloatRect attackHitbox;
+
+    // for the profiler overlay
+    StreamingStats streaming{};
+
+    // interpolation factor at publish time; the renderer advances it by the
+    // time passed since publishedAt
+    float alpha = 0.f;
+    std::chrono::steady_clock::time_point publishedAt;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/ResourceManager.hpp"
+
+// Binary atlas index written by tools/atlas_packer.cpp (little-endian):
+//   header    magic "IANHATLS", u32 version, u32 pageCount, u32 sequenceCount, u32 frameCount
+//   pages     u16 length + page image file name (next to the index file)
+//   sequences u16 length + name, u32 firstFrame, u32 frameCount
+//   frames    u16 page, u16 left, u16 top, u16 width, u16 height
+// A sequence is one source sheet, its frames are the sheet cells in row-major
+// order. Empty cells keep their slot with a zero-sized rect.
+namespace AtlasFormat
+{
+    const char MAGIC[8] = {'I', 'A', 'N', 'H', 'A', 'T', 'L', 'S'};
+    const std::uint32_t VERSION = 1;
+}
+
+struct AtlasFrame
+{
+    std::uint16_t page;
+    sf::IntRect rect;
+};
+
+struct AtlasSequence
+{
+    std::uint32_t firstFrame;
+    std::uint32_t frameCount;
+};
+
+class SpriteAtlas
+{
+private:
+    std::vector<std::string> m_pagePaths;
+    std::vector<TextureHandle> m_pages;
+    std::vector<AtlasFrame> m_frames;
+    std::unordered_map<std::string, AtlasSequence> m_sequences;
+
+    // size is the whole index in bytes, counts in the header are checked against it
+    bool readIndex(std::istream &in, std::uint64_t size, const std::string &indexPath);
+
+public:
+    bool loadFromFile(const std::string &indexPath, ResourceManager &resources);
+
+    // two-step loading for background loaders: read the index, load the page
+    // textures from getPagePaths() elsewhere, then bind them from the cache.
+    // The index is read from the resources' asset pack when it has one.
+    bool loadIndex(const std::string &indexPath, const ResourceManager &resources);
+    const std::vector<std::string> &getPagePaths() const;
+    bool bindPages(ResourceManager &resources);
+
+    // nullptr if the atlas has no sequence with that name
+    const AtlasSequence *findSequence(const std::string &name) const;
+
+    const AtlasFrame &getFrame(std::uint32_t id) const;
+    const TextureHandle &getPage(std::uint16_t page) const;
+    std::size_t getFrameCount() const;
+    bool isLoaded() const;
+};
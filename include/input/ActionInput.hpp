@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <array>
+#include <vector>
+#include "input/PlayerInput.hpp"
+
+// Turns the window's key events into actions. Game hands it every event it
+// drains in processEvents, then takes one PlayerInput per fixed step; keys
+// are never polled, so a tap between two steps still registers.
+class ActionInput
+{
+private:
+    struct Binding
+    {
+        sf::Keyboard::Key key;
+        Action action;
+    };
+
+    std::vector<Binding> m_bindings;
+    std::array<bool, sf::Keyboard::KeyCount> m_keyDown;
+    // bound keys held per action, an action is held while any of them is
+    std::array<std::uint8_t, static_cast<std::size_t>(Action::Count)> m_keysHeld;
+    ActionBits m_pressed; // since the last takeStep
+    ActionBits m_released;
+
+    void setKey(sf::Keyboard::Key key, bool down);
+
+public:
+    // with the default bindings
+    ActionInput();
+
+    // a key may drive several actions and an action have several keys
+    void bind(sf::Keyboard::Key key, Action action);
+    void clearBindings();
+
+    void handleEvent(const sf::Event &event);
+    // releases everything, e.g. when the window loses focus
+    void releaseAll();
+
+    // held actions now and the edges since the last call
+    PlayerInput takeStep();
+};
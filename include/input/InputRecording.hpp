@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "input/PlayerInput.hpp"
+
+// Recording file (little-endian):
+//   header  magic "IANHINPT", u32 version, f32 timestep, u32 tickCount,
+//           u32 levelPathLength, level path bytes, u32 runCount
+//   runs    runCount times u8 held, u8 pressed, u8 released (ActionBits),
+//           u32 ticks in a row with that input
+//   hashes  tickCount times u64 world state hash after the tick
+// Input changes a few times a second at most, so runs keep the input part
+// small; the hashes are what let a replay check every tick.
+namespace InputFormat
+{
+    const char MAGIC[8] = {'I', 'A', 'N', 'H', 'I', 'N', 'P', 'T'};
+    const std::uint32_t VERSION = 2;
+    const std::size_t RUN_SIZE = 3 + 4;
+}
+
+// The input of every fixed step of a session, with the world's state hash
+// after each (World::getStateHash). Replaying the inputs into a world set up
+// the same way has to reproduce every hash.
+class InputRecording
+{
+private:
+    float m_timestep;
+    std::string m_levelPath;
+    std::vector<PlayerInput> m_inputs;   // one per tick
+    std::vector<std::uint64_t> m_hashes; // one per tick
+
+public:
+    InputRecording();
+
+    // starts an empty recording
+    void reset(float timestep, const std::string &levelPath);
+    void record(const PlayerInput &input, std::uint64_t stateHash);
+
+    bool loadFromFile(const std::string &path);
+    bool saveToFile(const std::string &path) const;
+
+    float getTimestep() const;
+    const std::string &getLevelPath() const;
+    std::size_t getTickCount() const;
+    PlayerInput getInput(std::size_t tick) const;
+    std::uint64_t getStateHash(std::size_t tick) const;
+};
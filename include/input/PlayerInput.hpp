@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// What the player can ask for, independent of the keys bound to it (see
+// ActionInput). The menu actions share keys with gameplay ones.
+enum class Action : std::uint8_t
+{
+    MoveLeft,
+    MoveRight,
+    Jump,
+    Attack,
+    MenuUp,
+    MenuDown,
+    MenuConfirm,
+    Count
+};
+
+// one bit per Action
+using ActionBits = std::uint8_t;
+
+constexpr ActionBits actionBit(Action action)
+{
+    return static_cast<ActionBits>(1u << static_cast<unsigned int>(action));
+}
+
+// Input for one simulation step: the actions held at the step, and the ones
+// that went down or up since the step before. A tap shorter than a step
+// comes through as pressed and released with nothing held. The game fills
+// it from key events (ActionInput), the headless benchmarks from a script
+// and replays from a recording; the player and the menu only read it.
+struct PlayerInput
+{
+    ActionBits held = 0;
+    ActionBits pressed = 0;
+    ActionBits released = 0;
+
+    bool isHeld(Action action) const;
+    bool wasPressed(Action action) const;
+    bool wasReleased(Action action) const;
+    // held, or pressed at some point during the step
+    bool isActive(Action action) const;
+
+    // edges worked out from the held actions of two steps in a row, for scripts
+    static PlayerInput fromHeld(ActionBits held, ActionBits previousHeld);
+};
+
+// Remembers presses for a few steps, so a jump pressed just before landing
+// or an attack pressed while the last one is still cooling down happens as
+// soon as it can instead of being dropped.
+class InputBuffer
+{
+private:
+    static constexpr std::uint16_t NO_PRESS = 0xFFFF;
+
+    // steps since each action's last press that nothing consumed yet
+    std::array<std::uint16_t, static_cast<std::size_t>(Action::Count)> m_age;
+
+public:
+    InputBuffer();
+
+    // once per step, before consume
+    void update(const PlayerInput &input);
+    // true once per press made within the last window steps (0: this step)
+    bool consume(Action action, std::uint16_t window);
+    void clear();
+};
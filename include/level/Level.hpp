@@ -0,0 +1,163 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "core/AssetPack.hpp"
+
+class ResourceManager;
+
+// Level file written by tools/level_importer.cpp (little-endian):
+//   header   magic "IANHLEVL", u32 version, u32 tileWidth, u32 tileHeight,
+//            u32 width, u32 height (in tiles), u32 tilesetColumns,
+//            u32 layerCount, u32 spawnCount, u32 flags, u32 regionSize
+//   spawns   spawnCount times u32 kind, f32 x, f32 y
+//   regions  table of u64 offset, u32 size, u32 tileCount per region, then
+//            the regions themselves
+// The map is cut into regionSize x regionSize tile regions (smaller at the
+// right and bottom edge), row by row, so each can be read on its own. A
+// region holds layerCount grids of u16 cells, then its u8 collision cells
+// with HAS_COLLISION. A tile cell is 0 when empty, otherwise tileset index
+// + 1 (index = row * tilesetColumns + column), the same numbering as a
+// Tiled gid with firstgid 1.
+namespace LevelFormat
+{
+    const char MAGIC[8] = {'I', 'A', 'N', 'H', 'L', 'E', 'V', 'L'};
+    const std::uint32_t VERSION = 2;
+    const std::uint32_t HAS_COLLISION = 1u << 0;
+    const std::size_t HEADER_SIZE = 8 + 10 * 4;
+    const std::size_t SPAWN_SIZE = 12;
+    const std::size_t REGION_ENTRY_SIZE = 16;
+
+    // regions line up with Ground's chunks, so this has to be a multiple of 16
+    const std::uint32_t DEFAULT_REGION_SIZE = 32;
+}
+
+enum class SpawnKind : std::uint32_t
+{
+    Player = 0,
+    Enemy = 1,
+    Torch = 2, // a flame, only drawn (see Game::addTorches)
+    Count
+};
+
+struct LevelSpawn
+{
+    SpawnKind kind;
+    sf::Vector2f position;
+};
+
+struct LevelInfo
+{
+    std::uint32_t width; // in tiles
+    std::uint32_t height;
+    std::uint32_t tileWidth;
+    std::uint32_t tileHeight;
+    std::uint32_t tilesetColumns;
+    std::uint32_t layerCount;
+    std::uint32_t regionSize;
+    bool hasCollision;
+
+    std::uint32_t getRegionColumns() const;
+    std::uint32_t getRegionRows() const;
+};
+
+// One region's cells, layout as in the file
+struct LevelRegion
+{
+    std::uint32_t index;
+    std::uint32_t x; // first tile column and row
+    std::uint32_t y;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::vector<std::uint16_t> tiles;    // layer grids back to back
+    std::vector<std::uint8_t> collision; // empty without a collision layer
+};
+
+// Header, spawns and region table of a level file. Regions are read one at
+// a time, straight from the pack mapping or with a seek into the loose
+// file, so a large map never has to be resident all at once.
+class LevelFile
+{
+private:
+    struct RegionEntry
+    {
+        std::uint64_t offset;
+        std::uint32_t size;
+        std::uint32_t tileCount;
+    };
+
+    std::string m_path;
+    std::optional<AssetPack::Blob> m_blob;
+    mutable std::ifstream m_file;
+    LevelInfo m_info;
+    std::vector<LevelSpawn> m_spawns;
+    std::vector<RegionEntry> m_regions;
+
+    bool readAt(std::uint64_t offset, void *out, std::size_t size) const;
+
+public:
+    LevelFile();
+
+    bool open(const std::string &path, const ResourceManager &resources);
+
+    const LevelInfo &getInfo() const;
+    const std::vector<LevelSpawn> &getSpawns() const;
+    std::uint32_t getRegionCount() const;
+    // tiles Ground will hold for the region, known before reading it
+    std::uint32_t getRegionTileCount(std::uint32_t region) const;
+
+    // one reader at a time: a loose file shares its stream between calls
+    bool readRegion(std::uint32_t region, LevelRegion &out) const;
+};
+
+// A whole tile map held as flat grids, for building levels (importer,
+// benchmarks) and for loading small ones outright.
+class Level
+{
+private:
+    LevelInfo m_info;
+    std::vector<std::uint16_t> m_tiles;    // every layer back to back
+    std::vector<std::uint8_t> m_collision; // empty: every tile is solid
+    std::vector<LevelSpawn> m_spawns;
+
+public:
+    Level();
+
+    // empty map to fill in with setTile/setSolid/addSpawn (importer, benchmarks)
+    void create(std::uint32_t width, std::uint32_t height, std::uint32_t tileWidth, std::uint32_t tileHeight,
+                std::uint32_t tilesetColumns, std::uint32_t layerCount, bool hasCollision);
+    // tiles per region side when saving, a multiple of 16
+    void setRegionSize(std::uint32_t regionSize);
+
+    // read from the resources' asset pack when it has the file
+    bool loadFromFile(const std::string &path, const ResourceManager &resources);
+    bool saveToFile(const std::string &path) const;
+
+    const LevelInfo &getInfo() const;
+    std::uint32_t getWidth() const;
+    std::uint32_t getHeight() const;
+    std::uint32_t getTileWidth() const;
+    std::uint32_t getTileHeight() const;
+    std::uint32_t getTilesetColumns() const;
+    std::uint32_t getLayerCount() const;
+
+    std::uint16_t getTile(std::uint32_t layer, std::uint32_t x, std::uint32_t y) const;
+    void setTile(std::uint32_t layer, std::uint32_t x, std::uint32_t y, std::uint16_t cell);
+    // width * height cells of one layer, the layers follow each other
+    const std::uint16_t *getLayer(std::uint32_t layer) const;
+
+    bool hasCollisionLayer() const;
+    // width * height cells, nullptr without a collision layer
+    const std::uint8_t *getCollisionLayer() const;
+    // without a collision layer any tile on any layer is solid
+    bool isSolid(std::uint32_t x, std::uint32_t y) const;
+    void setSolid(std::uint32_t x, std::uint32_t y, bool solid);
+
+    const std::vector<LevelSpawn> &getSpawns() const;
+    void addSpawn(SpawnKind kind, sf::Vector2f position);
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "components/Ground.hpp"
+#include "level/Level.hpp"
+
+struct StreamingSettings
+{
+    float loadRadius;              // px from the camera center
+    float unloadRadius;            // px, larger than loadRadius so a region on the edge does not thrash
+    std::size_t maxResidentTiles;  // hard cap, counting regions still loading
+};
+
+struct StreamingStats
+{
+    std::size_t residentRegions;
+    std::size_t residentTiles;
+    std::size_t residentBytes;
+    std::size_t pendingLoads;
+    std::size_t loadsCompleted;
+    std::size_t loadsFailed; // reads that failed; the region is tried again later
+    std::size_t evictions;
+    std::size_t loadsDeferred; // regions in range held back by maxResidentTiles right now
+    // request to swap-in, in milliseconds
+    float lastLoadMs;
+    float averageLoadMs;
+    float maxLoadMs;
+};
+
+// Keeps the regions of a level around a point resident in Ground. Regions
+// inside loadRadius are read and built on a worker thread, then swapped in
+// on the simulation thread; regions beyond unloadRadius are evicted.
+class LevelStreamer
+{
+private:
+    enum class RegionState : std::uint8_t
+    {
+        Unloaded,
+        Pending,
+        Resident
+    };
+
+    struct Request
+    {
+        std::uint32_t region;
+        const Ground *ground;
+    };
+
+    // a region that failed to read waits this long before it is asked for again
+    static constexpr std::chrono::milliseconds RETRY_DELAY{1000};
+
+    struct Candidate
+    {
+        float distance;
+        std::uint32_t region;
+    };
+
+    StreamingSettings m_settings;
+    LevelFile m_file;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorker;
+    std::deque<Request> m_requests;
+    std::deque<Ground::PreparedRegion> m_prepared;
+    std::condition_variable m_workerIdle;
+    bool m_workerBusy; // between taking a request and handing back its result
+    bool m_stopping;
+
+    // only touched on the simulation thread
+    std::vector<RegionState> m_states;
+    std::vector<std::chrono::steady_clock::time_point> m_requestedAt;
+    std::vector<std::chrono::steady_clock::time_point> m_retryAt; // failed reads only
+    std::vector<std::uint32_t> m_resident;
+    std::vector<Candidate> m_candidates;
+    std::vector<Ground::PreparedRegion> m_arrived;
+    std::size_t m_budgetTiles;
+    double m_totalLoadMs;
+    StreamingStats m_stats;
+
+    void workerLoop();
+    float distanceTo(std::uint32_t region, sf::Vector2f center) const;
+    void evict(std::uint32_t region, Ground &ground);
+
+public:
+    explicit LevelStreamer(const StreamingSettings &settings);
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer &) = delete;
+    LevelStreamer &operator=(const LevelStreamer &) = delete;
+
+    // header, spawns and region table only; regions come in through update.
+    // Opening again drops whatever was requested from the previous file
+    bool open(const std::string &path, const ResourceManager &resources);
+    const LevelFile &getFile() const;
+
+    // simulation thread, every step: swap in finished regions, evict far
+    // ones and request the nearest missing ones the memory cap allows
+    void update(sf::Vector2f center, Ground &ground);
+
+    const StreamingStats &getStats() const;
+};
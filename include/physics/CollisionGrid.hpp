@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform-grid spatial hash over static collision boxes. Every box is listed
+// in each cell it touches, a query only visits the cells under the region.
+class CollisionGrid
+{
+private:
+    float m_cellWidth;
+    float m_cellHeight;
+    std::vector<sf::FloatRect> m_boxes;
+    std::unordered_map<std::int64_t, std::vector<std::uint32_t>> m_cells;
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+    static std::int64_t cellKey(int x, int y);
+
+public:
+    CollisionGrid(float cellWidth, float cellHeight);
+
+    void insert(const sf::FloatRect &box);
+    // takes out a box inserted earlier, equal to it exactly; the last box
+    // moves into its slot, so getBoxes order changes
+    bool remove(const sf::FloatRect &box);
+    void clear();
+
+    // appends every box overlapping (or touching) region to out, each once
+    void query(const sf::FloatRect &region, std::vector<sf::FloatRect> &out) const;
+
+    const std::vector<sf::FloatRect> &getBoxes() const;
+};
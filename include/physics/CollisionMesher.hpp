@@ -0,0 +1,9 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+// Greedy meshing of solid boxes: boxes sharing a row are joined into runs,
+// then runs with the same horizontal span are stacked into blocks. The result
+// covers exactly the same area as the input, with far fewer rectangles.
+std::vector<sf::FloatRect> mergeCollisionBoxes(std::vector<sf::FloatRect> boxes);
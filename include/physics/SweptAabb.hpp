@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+// Overlap up to this deep (float error after snapping to a contact) still
+// counts as touching, not as already inside.
+const float SWEEP_SKIN = 0.01f;
+
+struct SweepHit
+{
+    float time;          // fraction of the motion before contact, 0..1
+    sf::Vector2f normal; // face of the obstacle that was hit, axis aligned
+    float contact;       // coordinate of that face on the normal's axis
+};
+
+// First contact of box moving by motion against obstacle. False if they
+// never touch during the move, if box only slides along a face, or if box
+// already overlaps obstacle (it is left free to move out).
+bool sweepBox(const sf::FloatRect &box, sf::Vector2f motion, const sf::FloatRect &obstacle, SweepHit &hit);
+
+struct SlideResult
+{
+    sf::FloatRect box; // where box ended up
+    bool hitFloor;
+    bool hitCeiling;
+    bool hitWall;
+};
+
+// Moves box by motion, stopping at the earliest contact among obstacles and
+// sliding the rest of the motion along the contact face. Nothing is skipped
+// however long the motion is, obstacles only need to cover the swept path.
+SlideResult sweepAndSlide(sf::FloatRect box, sf::Vector2f motion, const std::vector<sf::FloatRect> &obstacles);
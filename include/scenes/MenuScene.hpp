@@ -6,25 +6,37 @@
 #include <memory>
 #include <optional>
 #include "components/Button.hpp"
+#include "core/ResourceManager.hpp"
+#include "input/PlayerInput.hpp"
 
 class Menu
 {
 private:
     sf::RectangleShape background;
-    sf::Font font;
+    FontHandle font;
     std::optional<sf::Text> titleText;
 
     std::vector<std::unique_ptr<Button>> buttons;
+    int selectedButton; // keyboard focus, -1 for none
+
+    // Loading progress bar, hidden once everything is loaded
+    sf::RectangleShape loadingBarBack;
+    sf::RectangleShape loadingBarFill;
+    std::optional<sf::Text> loadingText;
+    float loadingProgress;
 
 public:
     Menu(float windowWidth, float windowHeight);
 
-    bool loadFont(const std::string &fontPath);
+    bool setFont(FontHandle menuFont);
     Button *addButton(const std::string &text, float y);
+    void setLoadingProgress(float progress);
 
     void handleMouseMove(sf::Vector2f mousePos);
     void handleMousePress(sf::Vector2f mousePos);
     void handleMouseRelease();
+    // MenuUp/MenuDown move the focus, MenuConfirm clicks the focused button
+    void handleActions(const PlayerInput &input);
 
     void draw(sf::RenderWindow &window);
 };
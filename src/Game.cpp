@@ -1,32 +1,82 @@
 #include "Game.hpp"
+#include "core/Profiler.hpp"
+#include "core/RenderStats.hpp"
+#include "core/Tracer.hpp"
+#include "level/Level.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <optional>
-#include <algorithm>
+#include <random>
+#include <utility>
 
-Game::Game()
+Game::Game(const GameOptions &gameOptions)
     : window(sf::VideoMode({Paths::WINDOW_WIDTH, Paths::WINDOW_HEIGHT}), "I am not a hero"),
       gameState(GameState::Menu),
+      running(true),
+      rendering(false),
+      menuView(sf::FloatRect({0.f, 0.f}, {static_cast<float>(Paths::WINDOW_WIDTH), static_cast<float>(Paths::WINDOW_HEIGHT)})),
+      showProfiler(false),
+      loader(resources),
+      atlas(std::make_shared<SpriteAtlas>()),
+      animations(std::make_shared<AnimationLibrary>()),
+      enemyAnimations(std::make_shared<AnimationLibrary>()),
+      assetsReady(false),
+      firstFrameShown(false),
       menu(static_cast<float>(Paths::WINDOW_WIDTH), static_cast<float>(Paths::WINDOW_HEIGHT)),
-      ground(Paths::GROUND_TILESET_TEXTURE, 32, 32),
-      player(Paths::PLAYER_IDLE_TEXTURE, Paths::PLAYER_RUN_TEXTURE, Paths::PLAYER_JUMP_TEXTURE, Paths::PLAYER_ATTACK_TEXTURE, 100.f, 100.f),
-      camera(sf::FloatRect({0.f, 0.f}, {800.f, 600.f})),
-      cameraSmoothing(0.1f),
-      mapWidth(1000),
-      mapHeight(1000),
-      tileSizeX(32),
-      tileSizeY(32)
+      torchFlames(1024),
+      sparks(2048),
+      sparkEmitter(0),
+      lightTime(0.f),
+      audio(resources, Audio::VOICE_COUNT),
+      musicState(GameState::Menu),
+      streamer(StreamingSettings{Streaming::LOAD_RADIUS, Streaming::UNLOAD_RADIUS, Streaming::MAX_RESIDENT_TILES}),
+      options(gameOptions),
+      replayTick(0),
+      replayDiverged(false),
+      fixedTimestep(Simulation::FIXED_TIMESTEP),
+      maxStepsPerFrame(Simulation::MAX_STEPS_PER_FRAME),
+      accumulator(0.f)
 {
-    window.setFramerateLimit(60);
+    Tracer::setThreadName("update");
+
+    // simulation runs on a fixed step, so rendering can follow the monitor
+    window.setVerticalSyncEnabled(true);
+    // input comes from key events, held keys must not repeat presses
+    window.setKeyRepeatEnabled(false);
+
+    world.setJobSystem(&jobs);
 
-    if (!menu.loadFont(Paths::FONT_PATH))
+    lighting.setScreenSize(window.getSize());
+    lighting.setResolutionScale(Lighting::RESOLUTION_SCALE);
+    lighting.setAmbient(sf::Color(70, 70, 110));
+
+    // everything below loads from the pack, loose files are the dev fallback
+    if (!resources.mountPack(Paths::ASSET_PACK))
+    {
+        std::cerr << "No asset pack, loading loose files from " << Paths::ASSET_PATH << std::endl;
+    }
+
+    // the one asset loaded up front: the menu and the loading label on its
+    // first frame are text, and opening the font from the mapped pack only
+    // reads its tables, glyphs are rasterised as they are first drawn
+    FontHandle font = resources.getFont(Paths::FONT_PATH);
+    if (!menu.setFont(font))
     {
         std::cerr << "Failed to load font for menu!" << std::endl;
     }
+    profilerOverlay.setFont(font);
 
     // Buttons
     Button *playButton = menu.addButton("PLAY", 300.f);
     playButton->setOnClick([this]()
                            {
+        if (!assetsReady)
+        {
+            std::cout << "Still loading..." << std::endl;
+            return;
+        }
         gameState = GameState::Playing;
         std::cout << "Starting game..." << std::endl; });
 
@@ -36,30 +86,273 @@ Game::Game()
 
     Button *exitButton = menu.addButton("EXIT", 460.f);
     exitButton->setOnClick([this]()
-                           { window.close(); });
-
-    // Platforms (example layout)
-    ground.createHorizontalPlatform(0, mapHeight, 35, 1, 0); // ground bottom
-    ground.createHorizontalPlatform(0, 0, 35, 1, 0);         // wall top
-    ground.createVerticalPlatform(0, 0, 35, 2, 1);           // wall left
-    ground.createVerticalPlatform(mapWidth, 0, 35, 0, 1);    // wall right
-    ground.createHorizontalPlatform(200, 400, 8, 1, 0);      // platform middle
-    ground.createHorizontalPlatform(50, 300, 5, 1, 0);       // platform left top
-    ground.createHorizontalPlatform(500, 250, 6, 1, 0);      // platform right top
+                           { running = false; });
+
+    if (!audio.loadSound(SoundId::SwordSlash, Paths::SWORD_SLASH_SOUND))
+    {
+        std::cerr << "Failed to load attack sound!" << std::endl;
+    }
+    audio.setMusicVolume(Audio::MUSIC_VOLUME);
+    audio.playMusic(Paths::MENU_MUSIC);
+
+    // clips are tiny and gameplay needs their timing right away
+    if (animations->loadFromFile(Paths::KNIGHT_ANIMATIONS, resources))
+    {
+        world.getPlayer().setAnimations(animations);
+    }
+    else
+    {
+        std::cerr << "Failed to load player animations!" << std::endl;
+    }
+
+    if (enemyAnimations->loadFromFile(Paths::NIGHTBORNE_ANIMATIONS, resources))
+    {
+        world.setEnemyAnimations(enemyAnimations);
+    }
+    else
+    {
+        std::cerr << "Failed to load enemy animations!" << std::endl;
+    }
+
+    if (!options.replayPath.empty() && !recording.loadFromFile(options.replayPath))
+    {
+        options.replayPath.clear();
+    }
+    else if (!options.replayPath.empty() && recording.getTimestep() != fixedTimestep)
+    {
+        std::cerr << "Recording " << options.replayPath << " was made with a different timestep, not replaying it" << std::endl;
+        options.replayPath.clear();
+    }
+
+    if (!options.replayPath.empty() || !options.recordPath.empty())
+    {
+        std::string levelPath = options.replayPath.empty() ? Paths::LEVEL_1 : recording.getLevelPath();
+        if (options.replayPath.empty())
+        {
+            recording.reset(fixedTimestep, levelPath);
+        }
+
+        Level level;
+        if (level.loadFromFile(levelPath, resources))
+        {
+            world.loadLevel(level);
+            addLevelEffects(level.getInfo(), level.getSpawns());
+        }
+        else
+        {
+            std::cerr << "Failed to load level!" << std::endl;
+        }
+    }
+    // only the header is read here, regions stream in around the camera
+    else if (streamer.open(Paths::LEVEL_1, resources))
+    {
+        world.streamLevel(streamer);
+        addLevelEffects(streamer.getFile().getInfo(), streamer.getFile().getSpawns());
+    }
+    else
+    {
+        std::cerr << "Failed to load level!" << std::endl;
+    }
+
+    // World textures decode in the background while the menu is already up
+    loader.queueTexture(Paths::GROUND_TILESET_TEXTURE);
+    loader.queueTexture(Paths::BACKGROUND_LAYER_1);
+    loader.queueTexture(Paths::BACKGROUND_LAYER_2);
+    loader.queueTexture(Paths::BACKGROUND_LAYER_3);
+
+    if (atlas->loadIndex(Paths::CHARACTER_ATLAS, resources))
+    {
+        for (const std::string &pagePath : atlas->getPagePaths())
+        {
+            loader.queueTexture(pagePath);
+        }
+    }
+    else
+    {
+        std::cerr << "Failed to load character atlas!" << std::endl;
+    }
+
+    // sparks fly off the attack hitbox while it is active
+    ParticleSettings spark;
+    spark.rate = 400.f;
+    spark.lifetime = 0.3f;
+    spark.lifetimeJitter = 0.1f;
+    spark.velocityJitter = {160.f, 120.f};
+    spark.gravity = 700.f;
+    spark.startSize = 10.f;
+    spark.endSize = 3.f;
+    spark.startColor = sf::Color(255, 240, 180);
+    spark.endColor = sf::Color(255, 90, 20, 0);
+    sparkEmitter = sparks.addEmitter(spark, sf::FloatRect(), false);
+
+    loader.queueTexture(Paths::FLAME_PARTICLE_TEXTURE);
+    loader.queueTexture(Paths::TORCH_PARTICLE_TEXTURE);
+
+    menu.setLoadingProgress(loader.getProgress());
+}
+
+// a slow stream of rising flames and a light on every torch the level places
+void Game::addLevelEffects(const LevelInfo &info, const std::vector<LevelSpawn> &spawns)
+{
+    ParticleSettings flame;
+    flame.rate = 10.f;
+    flame.lifetime = 0.7f;
+    flame.lifetimeJitter = 0.15f;
+    flame.velocity = {0.f, -20.f};
+    flame.velocityJitter = {6.f, 6.f};
+    flame.gravity = -30.f;
+    flame.startSize = 24.f;
+    flame.endSize = 18.f;
+    flame.startColor = sf::Color(255, 210, 130);
+    flame.endColor = sf::Color(255, 70, 20, 0);
+
+    for (const LevelSpawn &spawn : spawns)
+    {
+        if (spawn.kind == SpawnKind::Torch)
+        {
+            // flames rise from a few pixels wide strip at the base
+            torchFlames.addEmitter(flame, sf::FloatRect(spawn.position - sf::Vector2f(3.f, 8.f), {6.f, 0.f}));
+            torchLights.push_back({spawn.position - sf::Vector2f(0.f, 12.f), Lighting::TORCH_RADIUS, sf::Color(255, 170, 90)});
+        }
+    }
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> randomX(0.f, static_cast<float>(info.width * info.tileWidth));
+    std::uniform_real_distribution<float> randomY(0.f, static_cast<float>(info.height * info.tileHeight));
+    std::uniform_int_distribution<int> randomLevel(60, 200);
+    for (std::size_t i = 0; i < options.testLights; i++)
+    {
+        sf::Color color(static_cast<std::uint8_t>(randomLevel(random)), static_cast<std::uint8_t>(randomLevel(random)),
+                        static_cast<std::uint8_t>(randomLevel(random)));
+        torchLights.push_back({{randomX(random), randomY(random)}, Lighting::TORCH_RADIUS, color});
+    }
+}
+
+// hand the loaded textures to the world once the background loader is done
+void Game::finishLoading()
+{
+    world.getGround().setTileset(resources.getTexture(Paths::GROUND_TILESET_TEXTURE));
+    torchFlames.setTexture(resources.getTexture(Paths::TORCH_PARTICLE_TEXTURE), {6, 6}, 34);
+    sparks.setTexture(resources.getTexture(Paths::FLAME_PARTICLE_TEXTURE), {6, 6}, 35);
+
+    // far layers follow the camera less; each one is a single repeating quad
+    const std::pair<std::string, float> backgroundLayers[] = {
+        {Paths::BACKGROUND_LAYER_1, 0.1f},
+        {Paths::BACKGROUND_LAYER_2, 0.3f},
+        {Paths::BACKGROUND_LAYER_3, 0.5f},
+    };
+    for (const auto &[path, scrollFactor] : backgroundLayers)
+    {
+        if (resources.setTextureRepeated(path, true))
+        {
+            background.addLayer(resources.getTexture(path), {scrollFactor, 0.f});
+        }
+    }
+
+    if (atlas->bindPages(resources) && animations->bind(*atlas) && enemyAnimations->bind(*atlas))
+    {
+        actors.setAtlas(atlas);
+    }
+
+    assetsReady = true;
+    menu.setLoadingProgress(1.f);
+
+    // a replay needs no one to press play
+    if (!options.replayPath.empty())
+    {
+        gameState = GameState::Playing;
+    }
+
+    std::cout << "Assets loaded in " << startupClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    resources.printReport(std::cout);
 }
 
 int Game::run()
 {
-    while (window.isOpen())
+    // hand the GL context to the render thread; texture uploads on this
+    // thread (AssetLoader) get a shared context from SFML
+    if (!window.setActive(false))
     {
-        float deltaTime = clock.restart().asSeconds();
+        std::cerr << "Failed to release the window context!" << std::endl;
+    }
+    rendering = true;
+    renderThread = std::thread(&Game::renderLoop, this);
 
-        sf::Vector2i mousePixelPos = sf::Mouse::getPosition(window);
-        sf::Vector2f mousePos = window.mapPixelToCoords(mousePixelPos);
+    while (running)
+    {
+        float frameTime = clock.restart().asSeconds();
+        accumulator += frameTime;
+
+        {
+            std::lock_guard<std::mutex> lock(windowMutex);
+
+            sf::Vector2i mousePixelPos = sf::Mouse::getPosition(window);
+            sf::Vector2f mousePos = window.mapPixelToCoords(mousePixelPos, menuView);
+
+            {
+                PROFILE_ZONE(ProfileZone::Events);
+                processEvents(mousePos);
+            }
+
+            if (gameState == GameState::Menu)
+            {
+                menu.handleActions(actions.takeStep());
+            }
+
+            // Upload whatever the loader threads decoded since last frame
+            if (!assetsReady)
+            {
+                loader.update();
+                menu.setLoadingProgress(loader.getProgress());
+                if (loader.isDone())
+                {
+                    finishLoading();
+                }
+            }
+        }
+
+        // Advance the simulation in fixed steps
+        int steps = 0;
+        while (accumulator >= fixedTimestep && steps < maxStepsPerFrame)
+        {
+            update(fixedTimestep);
+            accumulator -= fixedTimestep;
+            steps++;
+        }
 
-        processEvents(mousePos);
-        update(deltaTime, mousePos);
-        render();
+        // Too far behind (hitch, debugger, window drag): drop the backlog
+        if (accumulator >= fixedTimestep)
+        {
+            accumulator = 0.f;
+        }
+
+        if (gameState != musicState)
+        {
+            musicState = gameState;
+            audio.playMusic(musicState == GameState::Menu ? Paths::MENU_MUSIC : Paths::LEVEL_MUSIC, Audio::CROSSFADE_SECONDS);
+        }
+        audio.update(frameTime);
+
+        publishSnapshot();
+
+        // display() no longer paces this loop, sleep until the next step is due
+        sf::sleep(sf::seconds(fixedTimestep - accumulator));
+    }
+
+    rendering = false;
+    renderThread.join();
+    window.close();
+
+    if (!options.recordPath.empty() && recording.saveToFile(options.recordPath))
+    {
+        std::cout << "Recorded " << recording.getTickCount() << " steps to " << options.recordPath << std::endl;
+    }
+
+    // a capture still running is written out on exit
+    if (Tracer::isEnabled())
+    {
+        Tracer::stop();
+        Tracer::writeJson(Paths::TRACE_OUTPUT);
     }
 
     return 0;
@@ -71,11 +364,56 @@ void Game::processEvents(const sf::Vector2f &mousePos)
     {
         if (event->is<sf::Event::Closed>())
         {
-            window.close();
+            running = false;
+        }
+
+        // the light map follows the window, rebuilt on its next draw
+        if (const auto *resized = event->getIf<sf::Event::Resized>())
+        {
+            lighting.setScreenSize(resized->size);
+        }
+
+        actions.handleEvent(*event);
+
+        if (const auto *keyPressed = event->getIf<sf::Event::KeyPressed>())
+        {
+            if (keyPressed->code == sf::Keyboard::Key::F3)
+            {
+                showProfiler = !showProfiler;
+            }
+
+            // light map resolution: full, half, quarter
+            if (keyPressed->code == sf::Keyboard::Key::F5)
+            {
+                float scale = lighting.getResolutionScale();
+                lighting.setResolutionScale(scale > 0.75f ? 0.5f : (scale > 0.375f ? 0.25f : 1.f));
+                std::cout << "Light map at " << lighting.getResolutionScale() * 100.f << "% resolution" << std::endl;
+            }
+
+            // first press starts a trace capture, the next one writes it
+            if (keyPressed->code == sf::Keyboard::Key::F4)
+            {
+                if (Tracer::isEnabled())
+                {
+                    Tracer::stop();
+                    Tracer::writeJson(Paths::TRACE_OUTPUT);
+                }
+                else
+                {
+                    Tracer::start();
+                    std::cout << "Tracing, press F4 again to write " << Paths::TRACE_OUTPUT << std::endl;
+                }
+            }
         }
 
         if (gameState == GameState::Menu)
         {
+            // only on real movement, a still mouse leaves the keyboard focus be
+            if (event->is<sf::Event::MouseMoved>())
+            {
+                menu.handleMouseMove(mousePos);
+            }
+
             if (const auto *mousePressed = event->getIf<sf::Event::MouseButtonPressed>())
             {
                 if (mousePressed->button == sf::Mouse::Button::Left)
@@ -95,79 +433,220 @@ void Game::processEvents(const sf::Vector2f &mousePos)
     }
 }
 
-void Game::update(float deltaTime, const sf::Vector2f &mousePos)
+void Game::update(float deltaTime)
 {
-    if (gameState == GameState::Menu)
+    if (gameState == GameState::Playing)
     {
-        menu.handleMouseMove(mousePos);
-    }
-    else if (gameState == GameState::Playing)
-    {
-        player.handleInput();
-        player.update(deltaTime, ground.getCollisionBoxes());
-
-        // CAMERA FOLLOW PLAYER
-        sf::Vector2f targetCameraPos = player.getPosition();
-
-        float lookAheadDistance = 25.f;
-        if (!player.isFacingRight())
+        if (!options.replayPath.empty())
         {
-            targetCameraPos.x -= lookAheadDistance;
+            stepReplay(deltaTime);
         }
         else
         {
-            targetCameraPos.x += lookAheadDistance;
+            PlayerInput input = actions.takeStep();
+            world.step(deltaTime, input);
+            if (!options.recordPath.empty())
+            {
+                recording.record(input, world.getStateHash());
+            }
         }
 
-        sf::Vector2f currentCameraPos = camera.getCenter();
-        sf::Vector2f newCameraPos = currentCameraPos + (targetCameraPos - currentCameraPos) * cameraSmoothing;
-        camera.setCenter(newCameraPos);
+        // voices and buffers are all set up, this allocates nothing
+        if (world.getPlayer().hasAttackStarted())
+        {
+            audio.play(SoundId::SwordSlash, 1);
+        }
+    }
+}
 
-        // Limit camera within map bounds
-        float halfWidth = camera.getSize().x / 2.f;
-        float halfHeight = camera.getSize().y / 2.f;
+// one recorded step, checked against the state hash recorded after it
+void Game::stepReplay(float deltaTime)
+{
+    if (replayTick == recording.getTickCount())
+    {
+        return;
+    }
 
-        float minX = halfWidth;
-        float maxX = static_cast<float>(mapWidth) - halfWidth + static_cast<float>(tileSizeX);
-        float minY = halfHeight;
-        float maxY = static_cast<float>(mapHeight) - halfHeight + static_cast<float>(tileSizeY);
+    world.step(deltaTime, recording.getInput(replayTick));
+    if (!replayDiverged && world.getStateHash() != recording.getStateHash(replayTick))
+    {
+        replayDiverged = true;
+        std::cerr << "Replay diverged from the recording at step " << replayTick << std::endl;
+    }
 
-        sf::Vector2f boundedPos = camera.getCenter();
-        boundedPos.x = std::max(minX, std::min(boundedPos.x, maxX));
-        boundedPos.y = std::max(minY, std::min(boundedPos.y, maxY));
+    replayTick++;
+    if (replayTick == recording.getTickCount())
+    {
+        std::cout << "Replay finished: " << replayTick << " steps, "
+                  << (replayDiverged ? "state diverged" : "every state hash matched") << std::endl;
+        running = false;
+    }
+}
 
-        camera.setCenter(boundedPos);
+// copy what the renderer needs out of the world, then hand it over
+void Game::publishSnapshot()
+{
+    TRACE_ZONE("publish snapshot");
+
+    RenderSnapshot &snapshot = snapshots.back();
+    snapshot.showWorld = gameState == GameState::Playing;
+    snapshot.sprites.clear();
+
+    if (snapshot.showWorld)
+    {
+        const sf::View &camera = world.getCamera();
+        snapshot.previousCameraCenter = world.getPreviousCameraCenter();
+        snapshot.cameraCenter = camera.getCenter();
+        snapshot.cameraSize = camera.getSize();
 
-        window.setView(camera);
+        // a margin around the view covers the interpolated motion
+        sf::Vector2f margin(128.f, 128.f);
+        sf::FloatRect region(camera.getCenter() - camera.getSize() / 2.f - margin, camera.getSize() + margin * 2.f);
+        actors.capture(world.getRegistry(), region, snapshot.sprites);
+
+        const Player &player = world.getPlayer();
+        snapshot.playerPreviousPosition = player.getRenderPosition(0.f); // previous step
+        snapshot.playerPosition = player.getPosition();
+        snapshot.playerCollisionBox = player.getCollisionHitbox();
+        snapshot.attackHitboxActive = player.isAttackHitboxActive();
+        snapshot.attackHitbox = player.getAttackHitbox();
     }
+
+    snapshot.streaming = streamer.getStats();
+
+    snapshot.alpha = accumulator / fixedTimestep;
+    snapshot.publishedAt = std::chrono::steady_clock::now();
+    snapshots.publish();
 }
 
-void Game::render()
+void Game::renderLoop()
 {
-    window.clear(sf::Color(135, 206, 235));
+    Tracer::setThreadName("render");
 
-    if (gameState == GameState::Menu)
+    if (!window.setActive(true))
     {
-        menu.draw(window);
+        std::cerr << "Render thread failed to activate the window context!" << std::endl;
     }
-    else if (gameState == GameState::Playing)
+
+    lastFrameStart = std::chrono::steady_clock::now();
+
+    while (rendering)
     {
-        ground.draw(window);
-        player.draw(window);
-        player.drawAttackHitbox(window);
+        // whole frame, start to start, for the overlay's graph
+        auto frameStart = std::chrono::steady_clock::now();
+        float frameSeconds = std::chrono::duration<float>(frameStart - lastFrameStart).count();
+        Profiler::recordFrame(frameSeconds * 1000.f);
+        lastFrameStart = frameStart;
+
+        snapshots.update();
+        const RenderSnapshot &snapshot = snapshots.front();
+
+        // keep interpolating while no new snapshot arrives, up to the current step
+        float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot.publishedAt).count();
+        float alpha = std::min(1.f, snapshot.alpha + elapsed / fixedTimestep);
+
+        // after a long stall effects move on by at most 0.1 s
+        render(snapshot, alpha, std::min(frameSeconds, 0.1f));
+    }
+
+    // give the context back so the window thread can close the window
+    if (!window.setActive(false))
+    {
+        std::cerr << "Render thread failed to release the window context!" << std::endl;
+    }
+}
+
+void Game::render(const RenderSnapshot &snapshot, float alpha, float deltaTime)
+{
+    TRACE_ZONE("render");
+
+    {
+        std::lock_guard<std::mutex> lock(windowMutex);
+
+        RenderStats::reset();
+        window.clear(sf::Color(135, 206, 235));
 
-        // Debug player collision hitbox
-        sf::RectangleShape debugHitbox;
-        debugHitbox.setFillColor(sf::Color::Transparent);
-        debugHitbox.setOutlineColor(sf::Color::Green);
-        debugHitbox.setOutlineThickness(1.f);
+        if (!snapshot.showWorld)
+        {
+            window.setView(menuView);
+            menu.draw(window);
+        }
+        else
+        {
+            sf::View renderView(snapshot.cameraCenter, snapshot.cameraSize);
+            renderView.setCenter(snapshot.previousCameraCenter + (snapshot.cameraCenter - snapshot.previousCameraCenter) * alpha);
+            window.setView(renderView);
+
+            {
+                PROFILE_ZONE(ProfileZone::Particles);
+                sparks.setEmitterArea(sparkEmitter, snapshot.attackHitbox);
+                sparks.setEmitterActive(sparkEmitter, snapshot.attackHitboxActive);
+                torchFlames.update(deltaTime);
+                sparks.update(deltaTime);
+            }
 
-        sf::FloatRect collisionRect = player.getCollisionHitbox();
-        debugHitbox.setPosition(collisionRect.position);
-        debugHitbox.setSize(collisionRect.size);
+            background.draw(window, renderView);
+            world.getGround().draw(window, renderView);
+            actors.draw(window, renderView, snapshot.sprites, alpha);
 
-        window.draw(debugHitbox);
+            // torches flicker, the player carries a faint glow
+            lightTime += deltaTime;
+            frameLights.clear();
+            for (std::size_t i = 0; i < torchLights.size(); i++)
+            {
+                PointLight light = torchLights[i];
+                light.radius *= 0.92f + 0.08f * std::sin(lightTime * 9.f + static_cast<float>(i) * 1.7f);
+                frameLights.push_back(light);
+            }
+            sf::Vector2f playerRenderPosition = snapshot.playerPreviousPosition + (snapshot.playerPosition - snapshot.playerPreviousPosition) * alpha;
+            frameLights.push_back({playerRenderPosition, Lighting::PLAYER_RADIUS, sf::Color(110, 110, 130)});
+            lighting.draw(window, renderView, frameLights);
+
+            // flames and sparks give off light, they go over the light map
+            torchFlames.draw(window, renderView);
+            sparks.draw(window, renderView);
+
+            if (snapshot.attackHitboxActive)
+            {
+                sf::RectangleShape debugBox;
+                debugBox.setSize(snapshot.attackHitbox.size);
+                debugBox.setPosition(snapshot.attackHitbox.position);
+                debugBox.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
+                debugBox.setOutlineColor(sf::Color::Red);
+                debugBox.setOutlineThickness(2.f);
+                window.draw(debugBox);
+                RenderStats::addDrawCall(4);
+            }
+
+            // Debug player collision hitbox
+            sf::RectangleShape debugHitbox;
+            debugHitbox.setFillColor(sf::Color::Transparent);
+            debugHitbox.setOutlineColor(sf::Color::Green);
+            debugHitbox.setOutlineThickness(1.f);
+
+            debugHitbox.setPosition(snapshot.playerCollisionBox.position + playerRenderPosition - snapshot.playerPosition);
+            debugHitbox.setSize(snapshot.playerCollisionBox.size);
+
+            window.draw(debugHitbox);
+            RenderStats::addDrawCall(4);
+        }
+
+        // drawn last and not counted in RenderStats, so it never skews them
+        if (showProfiler)
+        {
+            profilerOverlay.draw(window, RenderStats::drawCalls, RenderStats::vertices, snapshot.streaming);
+        }
+    }
+
+    // vsync wait happens here, outside the lock
+    {
+        PROFILE_ZONE(ProfileZone::Display);
+        window.display();
     }
 
-    window.display();
+    if (!firstFrameShown)
+    {
+        firstFrameShown = true;
+        std::cout << "Time to first frame: " << startupClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+    }
 }
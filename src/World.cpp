@@ -0,0 +1,210 @@
+#include "World.hpp"
+#include "core/Hash.hpp"
+#include "core/Tracer.hpp"
+#include <algorithm>
+#include <cmath>
+
+World::World()
+    : ground(32, 32),
+      player(registry, 100.f, 100.f),
+      camera(sf::FloatRect({0.f, 0.f}, {800.f, 600.f})),
+      cameraSmoothing(0.1f),
+      previousCameraCenter(camera.getCenter()),
+      mapWidth(0),
+      mapHeight(0),
+      tileSizeX(32),
+      tileSizeY(32),
+      jobs(nullptr),
+      streamer(nullptr)
+{
+}
+
+void World::loadLevel(const Level &level)
+{
+    streamer = nullptr;
+    ground.loadLevel(level);
+    setupLevel(level.getInfo(), level.getSpawns());
+}
+
+void World::streamLevel(LevelStreamer &levelStreamer)
+{
+    const LevelFile &file = levelStreamer.getFile();
+    if (!ground.beginStreaming(file.getInfo()))
+    {
+        return;
+    }
+
+    streamer = &levelStreamer;
+    setupLevel(file.getInfo(), file.getSpawns());
+
+    // start on the player, so the first regions requested are the ones
+    // under the spawn
+    camera.setCenter(player.getPosition());
+    previousCameraCenter = camera.getCenter();
+    streamer->update(camera.getCenter(), ground);
+}
+
+void World::setupLevel(const LevelInfo &info, const std::vector<LevelSpawn> &spawns)
+{
+    // the last tile row and column start at the map edge, like the old
+    // hand-placed walls did
+    tileSizeX = static_cast<int>(info.tileWidth);
+    tileSizeY = static_cast<int>(info.tileHeight);
+    mapWidth = (static_cast<int>(info.width) - 1) * tileSizeX;
+    mapHeight = (static_cast<int>(info.height) - 1) * tileSizeY;
+
+    // everything but the player belonged to the previous level; going from
+    // the back, destroy() only ever swaps the player into the freed index
+    for (std::size_t i = registry.size(); i-- > 0;)
+    {
+        if (i != registry.indexOf(player.getEntity()))
+        {
+            registry.destroy(registry.entityAt(i));
+        }
+    }
+
+    for (const LevelSpawn &spawn : spawns)
+    {
+        if (spawn.kind == SpawnKind::Player)
+        {
+            player.setPosition(spawn.position);
+        }
+        else if (spawn.kind == SpawnKind::Enemy)
+        {
+            spawnEnemy(spawn.position);
+        }
+    }
+}
+
+Entity World::spawnEnemy(sf::Vector2f position)
+{
+    Entity enemy = registry.create(position);
+    std::size_t i = registry.indexOf(enemy);
+
+    // NightBorne frames are 80x80, feet on the bottom row of the frame
+    registry.colliders.localBox[i] = {{-12.f, -4.f}, {24.f, 28.f}};
+    registry.velocities.gravity[i] = 900.f;
+    registry.ai.kind[i] = AiKind::Chase;
+    registry.ai.speed[i] = 60.f;
+    registry.ai.aggroRange[i] = 250.f;
+
+    return enemy;
+}
+
+void World::setEnemyAnimations(std::shared_ptr<const AnimationLibrary> animations)
+{
+    enemyAi.setAnimations(std::move(animations));
+}
+
+void World::step(float deltaTime, const PlayerInput &input)
+{
+    TRACE_ZONE("world step");
+
+    previousCameraCenter = camera.getCenter();
+
+    // regions that finished loading join the ground before physics runs
+    if (streamer)
+    {
+        streamer->update(camera.getCenter(), ground);
+    }
+
+    player.handleInput(input);
+    enemyAi.update(registry, player.getPosition(), jobs);
+    physics.update(registry, ground, deltaTime, jobs);
+    animation.update(registry, deltaTime, jobs);
+    player.update(deltaTime);
+
+    updateCamera(deltaTime);
+}
+
+void World::updateCamera(float deltaTime)
+{
+    // CAMERA FOLLOW PLAYER
+    sf::Vector2f targetCameraPos = player.getPosition();
+
+    float lookAheadDistance = 25.f;
+    if (!player.isFacingRight())
+    {
+        targetCameraPos.x -= lookAheadDistance;
+    }
+    else
+    {
+        targetCameraPos.x += lookAheadDistance;
+    }
+
+    sf::Vector2f currentCameraPos = camera.getCenter();
+    // cameraSmoothing is tuned per 60 Hz frame, rescale it to this step
+    float followFactor = 1.f - std::pow(1.f - cameraSmoothing, deltaTime * 60.f);
+    sf::Vector2f newCameraPos = currentCameraPos + (targetCameraPos - currentCameraPos) * followFactor;
+    camera.setCenter(newCameraPos);
+
+    // Limit camera within map bounds
+    float halfWidth = camera.getSize().x / 2.f;
+    float halfHeight = camera.getSize().y / 2.f;
+
+    float minX = halfWidth;
+    float maxX = static_cast<float>(mapWidth) - halfWidth + static_cast<float>(tileSizeX);
+    float minY = halfHeight;
+    float maxY = static_cast<float>(mapHeight) - halfHeight + static_cast<float>(tileSizeY);
+
+    sf::Vector2f boundedPos = camera.getCenter();
+    boundedPos.x = std::max(minX, std::min(boundedPos.x, maxX));
+    boundedPos.y = std::max(minY, std::min(boundedPos.y, maxY));
+
+    camera.setCenter(boundedPos);
+}
+
+Ground &World::getGround()
+{
+    return ground;
+}
+
+void World::setJobSystem(JobSystem *jobSystem)
+{
+    jobs = jobSystem;
+}
+
+const Registry &World::getRegistry() const
+{
+    return registry;
+}
+
+Player &World::getPlayer()
+{
+    return player;
+}
+
+const Player &World::getPlayer() const
+{
+    return player;
+}
+
+const sf::View &World::getCamera() const
+{
+    return camera;
+}
+
+sf::Vector2f World::getPreviousCameraCenter() const
+{
+    return previousCameraCenter;
+}
+
+std::uint64_t World::getStateHash() const
+{
+    std::uint64_t hash = Hash::FNV_OFFSET;
+
+    for (std::size_t i = 0; i < registry.size(); i++)
+    {
+        Hash::addBytes(hash, &registry.transforms.position[i], sizeof(sf::Vector2f));
+        Hash::addBytes(hash, &registry.velocities.velocity[i], sizeof(sf::Vector2f));
+        Hash::addBytes(hash, &registry.colliders.onGround[i], sizeof(std::uint8_t));
+        Hash::addBytes(hash, &registry.animations.frame[i], sizeof(std::uint32_t));
+        Hash::addBytes(hash, &registry.animations.timer[i], sizeof(float));
+        Hash::addBytes(hash, &registry.animations.facingRight[i], sizeof(std::uint8_t));
+    }
+
+    sf::Vector2f cameraCenter = camera.getCenter();
+    Hash::addBytes(hash, &cameraCenter, sizeof(cameraCenter));
+
+    return hash;
+}
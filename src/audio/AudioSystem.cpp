@@ -0,0 +1,219 @@
+#include "audio/AudioSystem.hpp"
+#include <algorithm>
+#include <iostream>
+
+AudioSystem::AudioSystem(ResourceManager &resources, std::size_t voiceCount)
+    : m_resources(resources),
+      m_playCount(0),
+      m_soundVolume(100.f),
+      m_currentDeck(0),
+      m_musicVolume(60.f),
+      m_fadeDuration(0.f),
+      m_fadeElapsed(0.f),
+      m_fadeOutVolume(0.f)
+{
+    m_voices.reserve(voiceCount);
+    for (std::size_t i = 0; i < voiceCount; i++)
+    {
+        m_voices.emplace_back(m_silence);
+    }
+    m_voiceStates.assign(voiceCount, VoiceState{false, false, 0, 0});
+}
+
+bool AudioSystem::loadSound(SoundId id, const std::string &path)
+{
+    m_buffers[static_cast<std::size_t>(id)] = m_resources.getSoundBuffer(path);
+    return m_buffers[static_cast<std::size_t>(id)] != nullptr;
+}
+
+int AudioSystem::chooseVoice(const std::vector<VoiceState> &voices, int priority)
+{
+    // a free voice still holding this buffer is best: switching buffers
+    // registers the voice with the new one, which may allocate
+    const VoiceState *freeVoice = nullptr;
+    const VoiceState *victim = nullptr;
+    for (const VoiceState &voice : voices)
+    {
+        if (!voice.playing)
+        {
+            if (voice.holdsBuffer)
+            {
+                freeVoice = &voice;
+                break;
+            }
+            if (!freeVoice)
+            {
+                freeVoice = &voice;
+            }
+        }
+        else if (!victim || voice.priority < victim->priority ||
+                 (voice.priority == victim->priority && voice.startedAt < victim->startedAt))
+        {
+            victim = &voice;
+        }
+    }
+
+    const VoiceState *chosen = freeVoice;
+    if (!chosen)
+    {
+        if (!victim || victim->priority > priority)
+        {
+            return -1;
+        }
+        chosen = victim;
+    }
+    return static_cast<int>(chosen - voices.data());
+}
+
+bool AudioSystem::play(SoundId id, int priority, float pitch)
+{
+    const SoundBufferHandle &buffer = m_buffers[static_cast<std::size_t>(id)];
+    if (!buffer)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < m_voices.size(); i++)
+    {
+        m_voiceStates[i].playing = m_voices[i].getStatus() != sf::SoundSource::Status::Stopped;
+        m_voiceStates[i].holdsBuffer = &m_voices[i].getBuffer() == buffer.get();
+    }
+
+    int chosen = chooseVoice(m_voiceStates, priority);
+    if (chosen < 0)
+    {
+        return false;
+    }
+
+    sf::Sound &voice = m_voices[static_cast<std::size_t>(chosen)];
+    VoiceState &state = m_voiceStates[static_cast<std::size_t>(chosen)];
+    if (state.playing)
+    {
+        voice.stop();
+    }
+    if (!state.holdsBuffer)
+    {
+        voice.setBuffer(*buffer);
+    }
+    voice.setPitch(pitch);
+    voice.setVolume(m_soundVolume);
+    voice.play();
+    state.priority = priority;
+    state.startedAt = ++m_playCount;
+    return true;
+}
+
+bool AudioSystem::openTrack(sf::Music &deck, const std::string &path)
+{
+    // the pack stays mapped as long as the resources, so the deck can keep
+    // decoding from it
+    std::optional<AssetPack::Blob> blob = m_resources.findInPack(path);
+    bool opened = blob ? deck.openFromMemory(blob->data, blob->size) : deck.openFromFile(path);
+    if (!opened)
+    {
+        std::cerr << "Error opening music: " << path << std::endl;
+    }
+    return opened;
+}
+
+void AudioSystem::setDeckVolumes(float fade)
+{
+    m_decks[m_currentDeck].setVolume(m_musicVolume * fade);
+    m_decks[1 - m_currentDeck].setVolume(m_fadeOutVolume * (1.f - fade));
+}
+
+bool AudioSystem::playMusic(const std::string &path, float fadeSeconds)
+{
+    if (path == m_currentTrack)
+    {
+        return true;
+    }
+
+    // the idle deck takes the new track, the playing one fades out
+    std::size_t next = 1 - m_currentDeck;
+    sf::Music &deck = m_decks[next];
+    deck.stop();
+    if (!openTrack(deck, path))
+    {
+        return false;
+    }
+    deck.setLooping(true);
+
+    sf::Music &outgoing = m_decks[m_currentDeck];
+    m_fadeOutVolume = outgoing.getStatus() == sf::SoundSource::Status::Playing ? outgoing.getVolume() : 0.f;
+    m_currentDeck = next;
+    m_currentTrack = path;
+
+    if (fadeSeconds > 0.f)
+    {
+        m_fadeDuration = fadeSeconds;
+        m_fadeElapsed = 0.f;
+        setDeckVolumes(0.f);
+    }
+    else
+    {
+        m_fadeDuration = 0.f;
+        outgoing.stop();
+        setDeckVolumes(1.f);
+    }
+
+    deck.play();
+    return true;
+}
+
+void AudioSystem::stopMusic()
+{
+    for (sf::Music &deck : m_decks)
+    {
+        deck.stop();
+    }
+    m_currentTrack.clear();
+    m_fadeDuration = 0.f;
+}
+
+void AudioSystem::update(float deltaTime)
+{
+    if (m_fadeDuration <= 0.f)
+    {
+        return;
+    }
+
+    m_fadeElapsed += deltaTime;
+    float fade = std::min(m_fadeElapsed / m_fadeDuration, 1.f);
+    setDeckVolumes(fade);
+
+    if (fade >= 1.f)
+    {
+        m_decks[1 - m_currentDeck].stop();
+        m_fadeDuration = 0.f;
+    }
+}
+
+void AudioSystem::setMusicVolume(float volume)
+{
+    m_musicVolume = std::min(std::max(volume, 0.f), 100.f);
+    if (m_fadeDuration <= 0.f)
+    {
+        m_decks[m_currentDeck].setVolume(m_musicVolume);
+    }
+}
+
+void AudioSystem::setSoundVolume(float volume)
+{
+    m_soundVolume = std::min(std::max(volume, 0.f), 100.f);
+    for (sf::Sound &voice : m_voices)
+    {
+        voice.setVolume(m_soundVolume);
+    }
+}
+
+std::size_t AudioSystem::getVoiceCount() const
+{
+    return m_voices.size();
+}
+
+std::size_t AudioSystem::getPlayingVoiceCount() const
+{
+    return static_cast<std::size_t>(std::count_if(m_voices.begin(), m_voices.end(), [](const sf::Sound &voice)
+                                                  { return voice.getStatus() == sf::SoundSource::Status::Playing; }));
+}
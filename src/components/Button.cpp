@@ -19,7 +19,7 @@ Button::Button(float x, float y, float width, float height)
     m_shape.setOutlineColor(sf::Color::White);
 }
 
-void Button::setFont(sf::Font &buttonFont)
+void Button::setFont(const sf::Font &buttonFont)
 {
     m_font = &buttonFont;
 
@@ -92,9 +92,14 @@ void Button::setOnClick(std::function<void()> callback)
 }
 
 void Button::handleMouseMove(sf::Vector2f mousePos)
+{
+    setHovered(isMouseOver(mousePos));
+}
+
+void Button::setHovered(bool hovered)
 {
     bool wasHovered = m_isHovered;
-    m_isHovered = isMouseOver(mousePos);
+    m_isHovered = hovered;
 
     if (m_isHovered && !wasHovered)
     {
@@ -156,6 +161,14 @@ void Button::handleMouseRelease()
     }
 }
 
+void Button::click()
+{
+    if (m_onClick)
+    {
+        m_onClick();
+    }
+}
+
 bool Button::isMouseOver(sf::Vector2f mousePos) const
 {
     return m_shape.getGlobalBounds().contains(mousePos);
@@ -1,29 +1,216 @@
 #include "components/Ground.hpp"
+#include "core/Profiler.hpp"
+#include "core/RenderStats.hpp"
+#include "physics/CollisionMesher.hpp"
+#include <algorithm>
+#include <cmath>
 
-Ground::Ground(const std::string &tilesetPath, int tileW = 32, int tileH = 32)
-    : m_tileWidth(tileW), m_tileHeight(tileH)
+namespace
 {
-    if (!m_tileset.loadFromFile(tilesetPath))
+    // cells of a whole level or of one streamed region
+    struct TileGrid
     {
-        std::cerr << "Error loading tileset!" << std::endl;
+        const std::uint16_t *tiles;    // layer grids back to back
+        const std::uint8_t *collision; // nullptr: every drawn cell is solid
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t layerCount;
+        int tilesetColumns;
+    };
+
+    // calls visit(x, y, tileIndex, solid) for every tile the grid puts down
+    // in cells [x0, x1) x [y0, y1): one per non-empty layer cell, with the
+    // cell's solidity on the first, and a collision-only tile where a solid
+    // cell has nothing drawn
+    template <typename Visit>
+    void forEachGridTile(const TileGrid &grid, std::uint32_t x0, std::uint32_t y0, std::uint32_t x1, std::uint32_t y1, Visit visit)
+    {
+        std::size_t layerSize = static_cast<std::size_t>(grid.width) * grid.height;
+
+        for (std::uint32_t y = y0; y < y1; y++)
+        {
+            for (std::uint32_t x = x0; x < x1; x++)
+            {
+                std::size_t cellIndex = static_cast<std::size_t>(y) * grid.width + x;
+
+                bool solid = grid.collision && grid.collision[cellIndex] != 0;
+                bool placed = false;
+
+                for (std::uint32_t layer = 0; layer < grid.layerCount; layer++)
+                {
+                    std::uint16_t cell = grid.tiles[layer * layerSize + cellIndex];
+                    if (cell != 0)
+                    {
+                        int index = cell - 1;
+                        visit(x, y, sf::Vector2i(index % grid.tilesetColumns, index / grid.tilesetColumns),
+                              (solid || !grid.collision) && !placed);
+                        placed = true;
+                    }
+                }
+
+                if (solid && !placed)
+                {
+                    visit(x, y, sf::Vector2i(-1, -1), true);
+                }
+            }
+        }
+    }
+
+    // fills chunks from a grid whose first cell is map tile (originX, originY),
+    // chunk by chunk; chunkFor(chunkX, chunkY, tileCount) hands back the chunk
+    // to fill with its storage already sized, so nothing regrows
+    template <typename ChunkFor>
+    void buildChunks(const TileGrid &grid, std::uint32_t originX, std::uint32_t originY, sf::Vector2f tileSize,
+                     std::uint32_t chunkSize, ChunkFor chunkFor)
+    {
+        for (std::uint32_t y0 = 0; y0 < grid.height; y0 += chunkSize)
+        {
+            for (std::uint32_t x0 = 0; x0 < grid.width; x0 += chunkSize)
+            {
+                std::uint32_t x1 = std::min(x0 + chunkSize, grid.width);
+                std::uint32_t y1 = std::min(y0 + chunkSize, grid.height);
+
+                std::size_t count = 0;
+                forEachGridTile(grid, x0, y0, x1, y1, [&](std::uint32_t, std::uint32_t, sf::Vector2i, bool)
+                                { count++; });
+                if (count == 0)
+                {
+                    continue;
+                }
+
+                auto &chunk = chunkFor(static_cast<int>((originX + x0) / chunkSize), static_cast<int>((originY + y0) / chunkSize), count);
+                forEachGridTile(grid, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y, sf::Vector2i tileIndex, bool solid)
+                                { chunk.tiles.push_back({{(originX + x) * tileSize.x, (originY + y) * tileSize.y}, tileIndex, solid}); });
+            }
+        }
     }
+
+    // merge one chunk's solid tiles into as few boxes as possible
+    template <typename ChunkType>
+    void mergeChunkCollision(const ChunkType &chunk, sf::Vector2f tileSize)
+    {
+        std::vector<sf::FloatRect> tileBoxes;
+        tileBoxes.reserve(chunk.tiles.size());
+        for (const auto &tile : chunk.tiles)
+        {
+            if (tile.solid)
+            {
+                tileBoxes.push_back(sf::FloatRect(tile.position, tileSize));
+            }
+        }
+
+        chunk.collisionBoxes = mergeCollisionBoxes(std::move(tileBoxes));
+        chunk.collisionDirty = false;
+    }
+}
+
+Ground::Ground(int tileW = 32, int tileH = 32)
+    : m_tileWidth(tileW),
+      m_tileHeight(tileH),
+      m_tileCount(0),
+      m_streamedLevel{0, 0, 0, 0, 1, 0, 0, false},
+      m_collisionGrid(static_cast<float>(tileW), static_cast<float>(tileH)),
+      m_collisionDirty(false)
+{
+}
+
+// the tileset is only needed for drawing, headless worlds never set it
+void Ground::setTileset(TextureHandle tileset)
+{
+    m_tileset = std::move(tileset);
+}
+
+// chunk that owns a tile, picked by the tile's top-left corner
+sf::Vector2i Ground::chunkCoordOf(sf::Vector2f position) const
+{
+    float chunkW = static_cast<float>(m_tileWidth * CHUNK_SIZE);
+    float chunkH = static_cast<float>(m_tileHeight * CHUNK_SIZE);
+
+    return {static_cast<int>(std::floor(position.x / chunkW)),
+            static_cast<int>(std::floor(position.y / chunkH))};
+}
+
+std::int64_t Ground::chunkKey(int chunkX, int chunkY)
+{
+    return (static_cast<std::int64_t>(chunkX) << 32) | static_cast<std::uint32_t>(chunkY);
 }
 
 // add single tile at (x, y) with tile index in tileset (tileIndexX, tileIndexY)
 void Ground::addTile(float x, float y, int tileIndexX = 0, int tileIndexY = 0)
 {
-    sf::Sprite tile(m_tileset);
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+
+    sf::Vector2i coord = chunkCoordOf({x, y});
+    std::int64_t key = chunkKey(coord.x, coord.y);
+    Chunk &chunk = m_chunks[key];
+    chunk.tiles.push_back({{x, y}, {tileIndexX, tileIndexY}, true});
+    chunk.dirty = true;
+    markCollisionDirty(key, chunk);
+    m_tileCount++;
+}
+
+void Ground::loadLevel(const Level &level)
+{
+    clear();
 
-    // Set texture rect for the tile
-    tile.setTextureRect(sf::IntRect(
-        {tileIndexX * m_tileWidth, tileIndexY * m_tileHeight},
-        {m_tileWidth, m_tileHeight}));
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+    m_tileWidth = static_cast<int>(level.getTileWidth());
+    m_tileHeight = static_cast<int>(level.getTileHeight());
+    m_collisionGrid = CollisionGrid(static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
 
-    tile.setPosition({x, y});
-    m_tiles.push_back(tile);
+    TileGrid grid{level.getLayerCount() > 0 ? level.getLayer(0) : nullptr, level.getCollisionLayer(),
+                  level.getWidth(), level.getHeight(), level.getLayerCount(), static_cast<int>(level.getTilesetColumns())};
+    sf::Vector2f tileSize(static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
 
-    // add collision box
-    m_collisionBoxes.push_back(sf::FloatRect({x, y}, {static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight)}));
+    buildChunks(grid, 0, 0, tileSize, CHUNK_SIZE, [&](int chunkX, int chunkY, std::size_t count) -> Chunk &
+                {
+        std::int64_t key = chunkKey(chunkX, chunkY);
+        Chunk &chunk = m_chunks[key];
+        chunk.tiles.reserve(count);
+        chunk.dirty = true;
+        markCollisionDirty(key, chunk);
+        m_tileCount += count;
+        return chunk; });
+}
+
+// remove the tile placed at (x, y), returns false if there is none
+bool Ground::removeTile(float x, float y)
+{
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+
+    sf::Vector2i coord = chunkCoordOf({x, y});
+    auto it = m_chunks.find(chunkKey(coord.x, coord.y));
+    if (it == m_chunks.end())
+    {
+        return false;
+    }
+
+    std::vector<Tile> &tiles = it->second.tiles;
+    for (std::size_t i = 0; i < tiles.size(); i++)
+    {
+        if (tiles[i].position.x == x && tiles[i].position.y == y)
+        {
+            tiles[i] = tiles.back();
+            tiles.pop_back();
+            it->second.dirty = true;
+            markCollisionDirty(it->first, it->second);
+            m_tileCount--;
+
+            // its boxes are still in the grid until the rebuild, which
+            // will not find the chunk
+            if (tiles.empty())
+            {
+                for (const sf::FloatRect &box : it->second.collisionBoxes)
+                {
+                    m_collisionGrid.remove(box);
+                }
+                m_chunks.erase(it);
+            }
+            return true;
+        }
+    }
+
+    return false;
 }
 
 // make horizontal platform (left to right)
@@ -44,21 +231,324 @@ void Ground::createVerticalPlatform(float x, float startY, int length, int tileI
     }
 }
 
-void Ground::draw(sf::RenderWindow &window)
+// rebuild the quad batch (two triangles per tile) of one chunk
+void Ground::rebuildVertices(Chunk &chunk) const
+{
+    std::size_t drawnCount = static_cast<std::size_t>(std::count_if(chunk.tiles.begin(), chunk.tiles.end(), [](const Tile &tile)
+                                                                    { return tile.tileIndex.x >= 0; }));
+    chunk.vertices.resize(drawnCount * 6);
+
+    float tileW = static_cast<float>(m_tileWidth);
+    float tileH = static_cast<float>(m_tileHeight);
+
+    std::size_t drawn = 0;
+    for (const Tile &tile : chunk.tiles)
+    {
+        if (tile.tileIndex.x < 0)
+        {
+            continue;
+        }
+
+        sf::Vertex *quad = &chunk.vertices[drawn++ * 6];
+
+        float left = tile.position.x;
+        float top = tile.position.y;
+        float texLeft = static_cast<float>(tile.tileIndex.x * m_tileWidth);
+        float texTop = static_cast<float>(tile.tileIndex.y * m_tileHeight);
+
+        quad[0].position = {left, top};
+        quad[1].position = {left + tileW, top};
+        quad[2].position = {left, top + tileH};
+        quad[3].position = {left, top + tileH};
+        quad[4].position = {left + tileW, top};
+        quad[5].position = {left + tileW, top + tileH};
+
+        quad[0].texCoords = {texLeft, texTop};
+        quad[1].texCoords = {texLeft + tileW, texTop};
+        quad[2].texCoords = {texLeft, texTop + tileH};
+        quad[3].texCoords = {texLeft, texTop + tileH};
+        quad[4].texCoords = {texLeft + tileW, texTop};
+        quad[5].texCoords = {texLeft + tileW, texTop + tileH};
+    }
+
+    chunk.dirty = false;
+}
+
+// draw only the chunks overlapping the view, so cost follows what is on screen
+void Ground::draw(sf::RenderWindow &window, const sf::View &view)
+{
+    PROFILE_ZONE(ProfileZone::GroundDraw);
+
+    if (!m_tileset)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+
+    sf::Vector2f viewMin = view.getCenter() - view.getSize() / 2.f;
+    sf::Vector2f viewMax = view.getCenter() + view.getSize() / 2.f;
+
+    // a tile belongs to the chunk of its top-left corner, so it may stick out
+    // one tile past its chunk; widen the lookup to catch those
+    viewMin.x -= static_cast<float>(m_tileWidth);
+    viewMin.y -= static_cast<float>(m_tileHeight);
+
+    sf::Vector2i first = chunkCoordOf(viewMin);
+    sf::Vector2i last = chunkCoordOf(viewMax);
+
+    for (int chunkY = first.y; chunkY <= last.y; chunkY++)
+    {
+        for (int chunkX = first.x; chunkX <= last.x; chunkX++)
+        {
+            auto it = m_chunks.find(chunkKey(chunkX, chunkY));
+            if (it == m_chunks.end())
+            {
+                continue;
+            }
+
+            Chunk &chunk = it->second;
+            if (chunk.dirty)
+            {
+                rebuildVertices(chunk);
+            }
+
+            if (chunk.vertices.getVertexCount() == 0)
+            {
+                continue;
+            }
+
+            window.draw(chunk.vertices, m_tileset.get());
+            RenderStats::addDrawCall(chunk.vertices.getVertexCount());
+        }
+    }
+}
+
+void Ground::markCollisionDirty(std::int64_t key, Chunk &chunk)
 {
-    for (const auto &tile : m_tiles)
+    if (!chunk.collisionDirty)
     {
-        window.draw(tile);
+        chunk.collisionDirty = true;
+        m_dirtyChunks.push_back(key);
+    }
+    m_collisionDirty = true;
+}
+
+// re-merge only the chunks whose tiles changed, swapping their old boxes in
+// the grid for the new ones; boxes stop at chunk edges, so an edit costs its
+// chunk and never the rest of the level
+void Ground::rebuildCollision() const
+{
+    sf::Vector2f tileSize(static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
+
+    for (std::int64_t key : m_dirtyChunks)
+    {
+        auto it = m_chunks.find(key);
+        if (it == m_chunks.end() || !it->second.collisionDirty)
+        {
+            continue;
+        }
+
+        const Chunk &chunk = it->second;
+        for (const sf::FloatRect &box : chunk.collisionBoxes)
+        {
+            m_collisionGrid.remove(box);
+        }
+        mergeChunkCollision(chunk, tileSize);
+        for (const sf::FloatRect &box : chunk.collisionBoxes)
+        {
+            m_collisionGrid.insert(box);
+        }
+    }
+
+    m_dirtyChunks.clear();
+    m_collisionDirty = false;
+}
+
+// queries rebuild lazily, which is not safe once several threads query at
+// once; call this first to do any pending rebuild up front
+void Ground::updateCollision() const
+{
+    if (m_collisionDirty)
+    {
+        rebuildCollision();
     }
 }
 
 const std::vector<sf::FloatRect> &Ground::getCollisionBoxes() const
 {
-    return m_collisionBoxes;
+    if (m_collisionDirty)
+    {
+        rebuildCollision();
+    }
+    return m_collisionGrid.getBoxes();
+}
+
+// collision boxes near region only, through the tile-cell grid
+void Ground::queryRegion(const sf::FloatRect &region, std::vector<sf::FloatRect> &out) const
+{
+    if (m_collisionDirty)
+    {
+        rebuildCollision();
+    }
+    m_collisionGrid.query(region, out);
 }
 
 void Ground::clear()
 {
-    m_tiles.clear();
-    m_collisionBoxes.clear();
-}
\ No newline at end of file
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+    m_chunks.clear();
+    m_tileCount = 0;
+    m_regionResident.clear();
+    m_collisionGrid.clear();
+    m_dirtyChunks.clear();
+    m_collisionDirty = false;
+}
+
+bool Ground::beginStreaming(const LevelInfo &level)
+{
+    if (level.regionSize == 0 || level.regionSize % CHUNK_SIZE != 0)
+    {
+        std::cerr << "Error: level regions of " << level.regionSize << " tiles do not line up with ground chunks" << std::endl;
+        return false;
+    }
+
+    clear();
+
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+    m_tileWidth = static_cast<int>(level.tileWidth);
+    m_tileHeight = static_cast<int>(level.tileHeight);
+    m_collisionGrid = CollisionGrid(static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
+    m_streamedLevel = level;
+    m_regionResident.assign(static_cast<std::size_t>(level.getRegionColumns()) * level.getRegionRows(), 0);
+    return true;
+}
+
+// everything that costs anything (tiles, vertices, merged collision) is
+// built here, so addRegion is left with moving chunks into place
+Ground::PreparedRegion Ground::prepareRegion(const LevelRegion &region) const
+{
+    PreparedRegion prepared{region.index, true, 0, {}};
+
+    TileGrid grid{region.tiles.data(), region.collision.empty() ? nullptr : region.collision.data(),
+                  region.width, region.height, m_streamedLevel.layerCount, static_cast<int>(m_streamedLevel.tilesetColumns)};
+    sf::Vector2f tileSize(static_cast<float>(m_tileWidth), static_cast<float>(m_tileHeight));
+
+    std::uint32_t chunksPerSide = m_streamedLevel.regionSize / CHUNK_SIZE;
+    prepared.chunks.reserve(static_cast<std::size_t>(chunksPerSide) * chunksPerSide);
+
+    buildChunks(grid, region.x, region.y, tileSize, CHUNK_SIZE, [&](int chunkX, int chunkY, std::size_t count) -> Chunk &
+                {
+        prepared.chunks.emplace_back(chunkKey(chunkX, chunkY), Chunk());
+        Chunk &chunk = prepared.chunks.back().second;
+        chunk.tiles.reserve(count);
+        prepared.tileCount += count;
+        return chunk; });
+
+    for (auto &[key, chunk] : prepared.chunks)
+    {
+        rebuildVertices(chunk);
+        mergeChunkCollision(chunk, tileSize);
+    }
+
+    return prepared;
+}
+
+void Ground::addRegion(PreparedRegion &&region)
+{
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+    for (auto &[key, chunk] : region.chunks)
+    {
+        // a chunk already there (tiles added by hand) gives up its boxes
+        auto existing = m_chunks.find(key);
+        if (existing != m_chunks.end())
+        {
+            for (const sf::FloatRect &box : existing->second.collisionBoxes)
+            {
+                m_collisionGrid.remove(box);
+            }
+            m_tileCount -= existing->second.tiles.size();
+        }
+
+        // merged in prepareRegion, only the grid entries are left to add
+        for (const sf::FloatRect &box : chunk.collisionBoxes)
+        {
+            m_collisionGrid.insert(box);
+        }
+        m_chunks.insert_or_assign(key, std::move(chunk));
+    }
+
+    m_tileCount += region.tileCount;
+    m_regionResident[region.index] = 1;
+}
+
+void Ground::removeRegion(std::uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(m_chunkMutex);
+
+    int chunksPerSide = static_cast<int>(m_streamedLevel.regionSize) / CHUNK_SIZE;
+    int firstX = static_cast<int>(index % m_streamedLevel.getRegionColumns()) * chunksPerSide;
+    int firstY = static_cast<int>(index / m_streamedLevel.getRegionColumns()) * chunksPerSide;
+
+    for (int chunkY = firstY; chunkY < firstY + chunksPerSide; chunkY++)
+    {
+        for (int chunkX = firstX; chunkX < firstX + chunksPerSide; chunkX++)
+        {
+            auto it = m_chunks.find(chunkKey(chunkX, chunkY));
+            if (it == m_chunks.end())
+            {
+                continue;
+            }
+
+            for (const sf::FloatRect &box : it->second.collisionBoxes)
+            {
+                m_collisionGrid.remove(box);
+            }
+            m_tileCount -= it->second.tiles.size();
+            m_chunks.erase(it);
+        }
+    }
+
+    m_regionResident[index] = 0;
+}
+
+bool Ground::isLoaded(const sf::FloatRect &area) const
+{
+    if (m_regionResident.empty())
+    {
+        return true;
+    }
+
+    // past the map edge counts as the nearest edge region
+    float regionWidth = static_cast<float>(m_streamedLevel.regionSize * m_tileWidth);
+    float regionHeight = static_cast<float>(m_streamedLevel.regionSize * m_tileHeight);
+    int lastColumn = static_cast<int>(m_streamedLevel.getRegionColumns()) - 1;
+    int lastRow = static_cast<int>(m_streamedLevel.getRegionRows()) - 1;
+
+    int firstX = std::clamp(static_cast<int>(std::floor(area.position.x / regionWidth)), 0, lastColumn);
+    int lastX = std::clamp(static_cast<int>(std::floor((area.position.x + area.size.x) / regionWidth)), 0, lastColumn);
+    int firstY = std::clamp(static_cast<int>(std::floor(area.position.y / regionHeight)), 0, lastRow);
+    int lastY = std::clamp(static_cast<int>(std::floor((area.position.y + area.size.y) / regionHeight)), 0, lastRow);
+
+    for (int y = firstY; y <= lastY; y++)
+    {
+        for (int x = firstX; x <= lastX; x++)
+        {
+            if (!m_regionResident[static_cast<std::size_t>(y) * (lastColumn + 1) + x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::size_t Ground::getTileCount() const
+{
+    return m_tileCount;
+}
+
+std::size_t Ground::getResidentBytes() const
+{
+    return m_tileCount * (sizeof(Tile) + 6 * sizeof(sf::Vertex));
+}
@@ -1,78 +1,24 @@
 #include "components/Player.hpp"
-
-Player::Player(const std::string &idleTexturePath,
-               const std::string &walkTexturePath,
-               const std::string &jumpTexturePath,
-               const std::string &attackTexturePath,
-               float positionX = 100.f,
-               float positionY = 100.f)
-    : m_sprite(m_idleTexture),
+#include "core/Profiler.hpp"
+#include "ecs/AnimationSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+Player::Player(Registry &registry, float positionX = 100.f, float positionY = 100.f)
+    : m_registry(registry),
+      m_entity(registry.create({positionX, positionY})),
       m_speed(120.f),
       m_jumpForce(-350.f),
-      m_gravity(900.f),
-      m_position(positionX, positionY),
-      m_velocity(0.f, 0.f),
-      m_isOnGround(false),
       m_isJumping(false),
-      m_isFacingRight(true),
       m_currentState(AnimationState::Idle),
       m_previousState(AnimationState::Idle),
-      m_currentFrameIndex(0),
-      m_animationTimer(0.f),
-      m_idleAnimSpeed(0.1f),
-      m_walkAnimSpeed(0.1f),
-      m_attackAnimSpeed(0.08f),
       m_isAttacking(false),
       m_attackCooldown(0.5f),
       m_attackCooldownTimer(0.f),
-      m_attackHitboxActive(false)
+      m_attackHitboxActive(false),
+      m_attackStarted(false)
 {
-    // Load textures
-    if (!m_idleTexture.loadFromFile(idleTexturePath))
-    {
-        std::cerr << "Error loading idle texture!" << std::endl;
-    }
-
-    if (!m_walkTexture.loadFromFile(walkTexturePath))
-    {
-        std::cerr << "Error loading walk texture!" << std::endl;
-    }
-
-    if (!m_jumpTexture.loadFromFile(jumpTexturePath))
-    {
-        std::cerr << "Error loading jump texture!" << std::endl;
-    }
-
-    if (!m_attackTexture.loadFromFile(attackTexturePath))
-    {
-        std::cerr << "Error loading attack texture!" << std::endl;
-    }
-
-    // configure default animation
-    m_idleAnim.m_columns = 2;
-    m_idleAnim.m_rows = 4;
-    m_idleAnim.m_frameCount = 8;
-
-    m_walkAnim.m_columns = 2;
-    m_walkAnim.m_rows = 4;
-    m_walkAnim.m_frameCount = 8;
-
-    m_jumpAnim.m_columns = 2;
-    m_jumpAnim.m_rows = 4;
-    m_jumpAnim.m_frameCount = 8;
-
-    m_attackAnim.m_columns = 8;
-    m_attackAnim.m_rows = 5;
-    m_attackAnim.m_frameCount = 9;
-
-    // Setup first frame
-    m_currentFrameWidth = static_cast<int>(m_idleTexture.getSize().x) / m_idleAnim.m_columns;
-    m_currentFrameHeight = static_cast<int>(m_idleTexture.getSize().y) / m_idleAnim.m_rows;
-
-    m_currentFrame = sf::IntRect({0, 0}, {m_currentFrameWidth, m_currentFrameHeight});
-    m_sprite.setTextureRect(m_currentFrame);
-    m_sprite.setOrigin({m_currentFrameWidth / 2.f, m_currentFrameHeight / 2.f});
-    m_sprite.setPosition(m_position);
+    m_clips.fill(nullptr);
 
     // init custom hitbox.
     float collisionWidth = 20.f;
@@ -85,53 +31,85 @@ Player::Player(const std::string &idleTexturePath,
     // };
 
     // if you want the hitbox to be below (for platformer):
-    m_collisionBox = {
-        {-(collisionWidth / 2.f), (m_currentFrameHeight / 2.f) - collisionHeight},
+    std::size_t i = index();
+    m_registry.colliders.localBox[i] = {
+        {-(collisionWidth / 2.f), (FRAME_HEIGHT / 2.f) - collisionHeight},
         {collisionWidth, collisionHeight}};
+    m_registry.velocities.gravity[i] = 900.f;
 }
 
-void Player::handleInput()
+// dense index of the player entity, looked up every time since destroying
+// other entities can move it
+std::size_t Player::index() const
 {
-    // Horizontal movement
-    m_velocity.x = 0.f;
+    return m_registry.indexOf(m_entity);
+}
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))
-    {
-        m_velocity.x = -m_speed;
-        m_isFacingRight = false;
-    }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right))
+// clip names in the animation file, indexed by AnimationState
+static const char *const CLIP_NAMES[] = {"idle", "run", "jump", "attack"};
+
+// clips drive gameplay timing (attack length, hitbox frames), so headless
+// worlds need them too
+void Player::setAnimations(std::shared_ptr<const AnimationLibrary> animations)
+{
+    std::array<const AnimationClip *, static_cast<std::size_t>(AnimationState::Count)> clips;
+    for (std::size_t i = 0; i < clips.size(); i++)
     {
-        m_velocity.x = m_speed;
-        m_isFacingRight = true;
+        clips[i] = animations ? animations->findClip(CLIP_NAMES[i]) : nullptr;
+        if (!clips[i])
+        {
+            std::cerr << "Error: missing player animation clip: " << CLIP_NAMES[i] << std::endl;
+            return;
+        }
     }
 
-    // Update scale for flip sprite
-    if (m_isFacingRight)
+    m_animations = std::move(animations);
+    m_clips = clips;
+    AnimationSystem::play(m_registry, index(), clipFor(m_currentState));
+}
+
+const AnimationClip *Player::clipFor(AnimationState state) const
+{
+    return m_clips[static_cast<std::size_t>(state)];
+}
+
+void Player::handleInput(const PlayerInput &input)
+{
+    PROFILE_ZONE(ProfileZone::Input);
+
+    m_attackStarted = false;
+
+    std::size_t i = index();
+    sf::Vector2f &velocity = m_registry.velocities.velocity[i];
+    std::uint8_t &facingRight = m_registry.animations.facingRight[i];
+    std::uint8_t &onGround = m_registry.colliders.onGround[i];
+
+    m_inputBuffer.update(input);
+
+    // Horizontal movement
+    velocity.x = 0.f;
+
+    if (input.isActive(Action::MoveLeft))
     {
-        m_sprite.setScale({1.f, 1.f}); // Normal
+        velocity.x = -m_speed;
+        facingRight = false;
     }
-    else
+    if (input.isActive(Action::MoveRight))
     {
-        m_sprite.setScale({-1.f, 1.f}); // Flip horizontal
+        velocity.x = m_speed;
+        facingRight = true;
     }
 
-    // Jump
-    if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space) ||
-         sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) ||
-         sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up)) &&
-        m_isOnGround && !m_isJumping)
+    // Jump, once per press; holding the key does not jump again on landing
+    if (onGround && !m_isJumping && m_inputBuffer.consume(Action::Jump, JUMP_BUFFER_STEPS))
     {
-        m_velocity.y = m_jumpForce;
+        velocity.y = m_jumpForce;
         m_isJumping = true;
-        m_isOnGround = false;
+        onGround = false;
     }
 
     // Attack
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::J) ||
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl))
+    if (canAttack() && m_inputBuffer.consume(Action::Attack, ATTACK_BUFFER_STEPS))
     {
         attack();
     }
@@ -142,11 +120,11 @@ void Player::handleInput()
     {
         m_currentState = AnimationState::Attacking;
     }
-    else if (!m_isOnGround)
+    else if (!onGround)
     {
         m_currentState = AnimationState::Jumping;
     }
-    else if (m_velocity.x != 0)
+    else if (velocity.x != 0)
     {
         m_currentState = AnimationState::Walking;
     }
@@ -154,254 +132,109 @@ void Player::handleInput()
     {
         m_currentState = AnimationState::Idle;
     }
+
+    // restart animation if state changed
+    if (m_currentState != m_previousState)
+    {
+        AnimationSystem::play(m_registry, i, clipFor(m_currentState));
+    }
+}
+
+bool Player::canAttack() const
+{
+    return !m_isAttacking && m_attackCooldownTimer <= 0.f;
 }
 
 void Player::attack()
 {
-    if (!m_isAttacking && m_attackCooldownTimer <= 0.f)
+    if (canAttack())
     {
         m_isAttacking = true;
+        m_attackStarted = true;
         m_attackCooldownTimer = m_attackCooldown;
-        m_currentFrameIndex = 0;
-        m_animationTimer = 0.f;
 
-        // activate on certain frame (example frame 3-5)
+        // restart even if the previous swing is still on screen, the hitbox
+        // turns on with the clip's hitbox frames
+        AnimationSystem::play(m_registry, index(), clipFor(AnimationState::Attacking));
         m_attackHitboxActive = false;
     }
 }
 
-void Player::updateAnimation(float deltaTime)
+void Player::update(float deltaTime)
 {
-    // change texture if state changed
-    if (m_currentState != m_previousState)
-    {
-        m_currentFrameIndex = 0;
-        m_animationTimer = 0.f;
-
-        if (m_currentState == AnimationState::Idle)
-        {
-            m_sprite.setTexture(m_idleTexture);
-            m_currentFrameWidth = static_cast<int>(m_idleTexture.getSize().x) / m_idleAnim.m_columns;
-            m_currentFrameHeight = static_cast<int>(m_idleTexture.getSize().y) / m_idleAnim.m_rows;
-        }
-        else if (m_currentState == AnimationState::Walking)
-        {
-            m_sprite.setTexture(m_walkTexture);
-            m_currentFrameWidth = static_cast<int>(m_walkTexture.getSize().x) / m_walkAnim.m_columns;
-            m_currentFrameHeight = static_cast<int>(m_walkTexture.getSize().y) / m_walkAnim.m_rows;
-        }
-        else if (m_currentState == AnimationState::Jumping)
-        {
-            m_sprite.setTexture(m_jumpTexture);
-            m_currentFrameWidth = static_cast<int>(m_jumpTexture.getSize().x) / m_jumpAnim.m_columns;
-            m_currentFrameHeight = static_cast<int>(m_jumpTexture.getSize().y) / m_jumpAnim.m_rows;
-        }
-        else if (m_currentState == AnimationState::Attacking)
-        {
-            m_sprite.setTexture(m_attackTexture);
-            m_currentFrameWidth = static_cast<int>(m_attackTexture.getSize().x) / m_attackAnim.m_columns;
-            m_currentFrameHeight = static_cast<int>(m_attackTexture.getSize().y) / m_attackAnim.m_rows;
-        }
-
-        m_sprite.setOrigin({m_currentFrameWidth / 2.f, m_currentFrameHeight / 2.f});
-    }
-
-    m_animationTimer += deltaTime;
-    AnimationConfig *currentAnim = nullptr;
-    float currentAnimSpeed = 0.f;
+    std::size_t i = index();
 
-    if (m_currentState == AnimationState::Idle)
-    {
-        currentAnim = &m_idleAnim;
-        currentAnimSpeed = m_idleAnimSpeed;
-    }
-    else if (m_currentState == AnimationState::Walking)
+    // Update cooldown timer
+    if (m_attackCooldownTimer > 0.f)
     {
-        currentAnim = &m_walkAnim;
-        currentAnimSpeed = m_walkAnimSpeed;
+        m_attackCooldownTimer -= deltaTime;
     }
-    else if (m_currentState == AnimationState::Jumping)
+
+    // only a landing sets onGround, which ends the jump
+    if (m_registry.colliders.onGround[i])
     {
-        currentAnim = &m_jumpAnim;
-        currentAnimSpeed = m_walkAnimSpeed;
+        m_isJumping = false;
     }
-    else if (m_currentState == AnimationState::Attacking)
+
+    // a finished attack clip hands back to the state machine
+    if (m_isAttacking && m_registry.animations.finished[i])
     {
-        currentAnim = &m_attackAnim;
-        currentAnimSpeed = m_attackAnimSpeed;
+        m_isAttacking = false;
     }
 
-    if (currentAnim && m_animationTimer >= currentAnimSpeed)
+    m_attackHitboxActive = m_isAttacking && (m_registry.animations.events[i] & AnimationEvent::HITBOX);
+    if (m_attackHitboxActive)
     {
-        m_animationTimer = 0.f;
-
-        // Handle attack animation
-        if (m_currentState == AnimationState::Attacking)
-        {
-            m_currentFrameIndex++;
-
-            // activate hitbox in frame 3-5
-            if (m_currentFrameIndex >= 3 && m_currentFrameIndex <= 5)
-            {
-                m_attackHitboxActive = true;
-                updateAttackHitbox();
-            }
-            else
-            {
-                m_attackHitboxActive = false;
-            }
-
-            // finish attack nimation
-            if (m_currentFrameIndex >= currentAnim->m_frameCount)
-            {
-                m_currentFrameIndex = 0;
-                m_isAttacking = false;
-                m_attackHitboxActive = false;
-            }
-        }
-        else
-        {
-            m_currentFrameIndex = (m_currentFrameIndex + 1) % currentAnim->m_frameCount;
-        }
-
-        int col = m_currentFrameIndex % currentAnim->m_columns;
-        int row = m_currentFrameIndex / currentAnim->m_columns;
-
-        m_currentFrame.position = {col * m_currentFrameWidth, row * m_currentFrameHeight};
-        m_currentFrame.size = {m_currentFrameWidth, m_currentFrameHeight};
-
-        m_sprite.setTextureRect(m_currentFrame);
+        updateAttackHitbox();
     }
 }
 
-void Player::applyPhysics(float deltaTime, const std::vector<sf::FloatRect> &groundBoxes)
+Entity Player::getEntity() const
 {
-    // Apply gravity
-    m_velocity.y += m_gravity * deltaTime;
-
-    // Simpan posisi lama
-    sf::Vector2f oldPosition = m_position;
-
-    // === GERAK HORIZONTAL ===
-    m_position.x += m_velocity.x * deltaTime;
-    m_sprite.setPosition(m_position);
-
-    // Check horizontal collision
-    sf::FloatRect playerBounds = getCollisionHitbox();
-    for (const auto &groundBox : groundBoxes)
-    {
-        if (playerBounds.findIntersection(groundBox))
-        {
-            m_position.x = oldPosition.x;
-            m_sprite.setPosition(m_position);
-            break;
-        }
-    }
-
-    // === GERAK VERTIKAL ===
-    m_position.y += m_velocity.y * deltaTime;
-    m_sprite.setPosition(m_position);
-
-    playerBounds = getCollisionHitbox();
-    m_isOnGround = false;
-
-    for (const auto &groundBox : groundBoxes)
-    {
-        if (playerBounds.findIntersection(groundBox))
-        {
-            // Landing on ground (dari atas)
-            if (m_velocity.y > 0)
-            {
-                // Gunakan .position.y dan .size.y
-                float playerBottom = playerBounds.position.y + playerBounds.size.y;
-                float groundTop = groundBox.position.y;
-
-                // Cek posisi lama (penting!)
-                float oldPlayerBottom = oldPosition.y + m_collisionBox.position.y + m_collisionBox.size.y;
-
-                // Cek jika frame sebelumnya DI ATAS ground
-                if (playerBottom > groundTop && oldPlayerBottom <= groundTop + 1.f)
-                {
-                    // Setel posisi player TEPAT di atas ground
-                    m_position.y = groundTop - m_collisionBox.position.y - m_collisionBox.size.y;
-
-                    m_velocity.y = 0.f;
-                    m_isOnGround = true;
-                    m_isJumping = false;
-                }
-            }
-            // Hitting ceiling (dari bawah)
-            else if (m_velocity.y < 0)
-            {
-                float playerTop = playerBounds.position.y;
-                float groundBottom = groundBox.position.y + groundBox.size.y;
-                float oldPlayerTop = oldPosition.y + m_collisionBox.position.y;
-
-                if (playerTop < groundBottom && oldPlayerTop >= groundBottom - 1.f)
-                {
-                    // Setel posisi player TEPAT di bawah ceiling
-                    m_position.y = groundBottom - m_collisionBox.position.y;
-                    m_velocity.y = 0.f;
-                }
-            }
-            m_sprite.setPosition(m_position);
-        }
-    }
+    return m_entity;
 }
 
-void Player::update(float deltaTime, const std::vector<sf::FloatRect> &groundBoxes)
+bool Player::isFacingRight() const
 {
-    // Update cooldown timer
-    if (m_attackCooldownTimer > 0.f)
-    {
-        m_attackCooldownTimer -= deltaTime;
-    }
+    return m_registry.animations.facingRight[index()];
+}
 
-    applyPhysics(deltaTime, groundBoxes);
-    updateAnimation(deltaTime);
+sf::Vector2f Player::getPosition() const
+{
+    return m_registry.transforms.position[index()];
 }
 
-void Player::draw(sf::RenderWindow &window)
+sf::Vector2f Player::getVelocity() const
 {
-    window.draw(m_sprite);
+    return m_registry.velocities.velocity[index()];
 }
 
-bool Player::isFacingRight()
+bool Player::isOnGround() const
 {
-    return m_isFacingRight;
+    return m_registry.colliders.onGround[index()];
 }
 
-sf::Vector2f Player::getPosition() const
+sf::Vector2f Player::getRenderPosition(float alpha) const
 {
-    return m_position;
+    std::size_t i = index();
+    sf::Vector2f previous = m_registry.transforms.previousPosition[i];
+    return previous + (m_registry.transforms.position[i] - previous) * alpha;
 }
 
 sf::FloatRect Player::getCollisionHitbox() const
 {
+    std::size_t i = index();
+
     // Ambil kotak lokal
-    sf::FloatRect globalBox = m_collisionBox;
+    sf::FloatRect globalBox = m_registry.colliders.localBox[i];
 
     // Geser posisinya ke posisi global player (yang merupakan origin)
-    globalBox.position.x += m_position.x;
-    globalBox.position.y += m_position.y;
+    globalBox.position.x += m_registry.transforms.position[i].x;
+    globalBox.position.y += m_registry.transforms.position[i].y;
 
     return globalBox;
 }
 
-void Player::drawAttackHitbox(sf::RenderWindow &window)
-{
-    if (m_attackHitboxActive)
-    {
-        sf::RectangleShape debugBox;
-        debugBox.setSize({m_attackHitbox.size.x, m_attackHitbox.size.y});
-        debugBox.setPosition({m_attackHitbox.position.x, m_attackHitbox.position.y});
-        debugBox.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
-        debugBox.setOutlineColor(sf::Color::Red);
-        debugBox.setOutlineThickness(2.f);
-        window.draw(debugBox);
-    }
-}
-
 sf::FloatRect Player::getAttackHitbox() const
 {
     return m_attackHitbox;
@@ -412,14 +245,9 @@ bool Player::isAttackHitboxActive() const
     return m_attackHitboxActive;
 }
 
-void Player::setAttackAnimation(int columns, int rows, int frameCount)
-{
-    m_attackAnim = {frameCount, columns, rows};
-}
-
-void Player::setAttackSpeed(float speed)
+bool Player::hasAttackStarted() const
 {
-    m_attackAnimSpeed = speed;
+    return m_attackStarted;
 }
 
 void Player::setAttackCooldown(float cooldown)
@@ -431,34 +259,28 @@ void Player::updateAttackHitbox()
 {
     float hitboxWidth = 60.f;
     float hitboxHeight = 40.f;
-    float offsetX = m_isFacingRight ? 40.f : -40.f;
+    float offsetX = isFacingRight() ? 40.f : -40.f;
+    sf::Vector2f position = getPosition();
 
     m_attackHitbox = sf::FloatRect(
-        {m_position.x + offsetX - hitboxWidth / 2.f, m_position.y - hitboxHeight / 2.f},
+        {position.x + offsetX - hitboxWidth / 2.f, position.y - hitboxHeight / 2.f},
         {hitboxWidth, hitboxHeight});
 }
 
-void Player::setIdleAnimation(int columns, int rows, int frameCount)
-{
-    m_idleAnim = {frameCount, columns, rows};
-}
-
-void Player::setWalkAnimation(int columns, int rows, int frameCount)
+void Player::setJumpForce(float force)
 {
-    m_walkAnim = {frameCount, columns, rows};
+    m_jumpForce = -abs(force);
 }
 
-void Player::setJumpAnimation(int columns, int rows, int frameCount)
+void Player::setGravity(float grav)
 {
-    m_jumpAnim = {frameCount, columns, rows};
+    m_registry.velocities.gravity[index()] = grav;
 }
 
-void Player::setJumpForce(float force)
+void Player::setPosition(sf::Vector2f position)
 {
-    m_jumpForce = -abs(force);
+    std::size_t i = index();
+    m_registry.transforms.position[i] = position;
+    m_registry.transforms.previousPosition[i] = position;
+    m_registry.velocities.velocity[i] = {0.f, 0.f};
 }
-
-void Player::setGravity(float grav)
-{
-    m_gravity = grav;
-}
\ No newline at end of file
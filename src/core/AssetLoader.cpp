@@ -0,0 +1,114 @@
+#include "core/AssetLoader.hpp"
+#include "core/Tracer.hpp"
+#include <algorithm>
+#include <iostream>
+#include <optional>
+
+AssetLoader::AssetLoader(ResourceManager &resources, unsigned int threadCount)
+    : m_resources(resources),
+      m_stopping(false),
+      m_queuedCount(0),
+      m_finishedCount(0)
+{
+    if (threadCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = std::max(1u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u);
+    }
+
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        m_workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_pending.clear();
+    }
+    m_wakeWorkers.notify_all();
+
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void AssetLoader::workerLoop()
+{
+    Tracer::setThreadName("asset loader");
+
+    while (true)
+    {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWorkers.wait(lock, [this]()
+                               { return m_stopping || !m_pending.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            path = std::move(m_pending.front());
+            m_pending.pop_front();
+        }
+
+        // file read and PNG decode happen here, off the window thread
+        TRACE_ZONE("decode texture");
+        DecodedImage decoded{path, sf::Image(), false};
+        std::optional<AssetPack::Blob> blob = m_resources.findInPack(path);
+        decoded.loaded = blob ? decoded.image.loadFromMemory(blob->data, blob->size)
+                              : decoded.image.loadFromFile(path);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.push_back(std::move(decoded));
+    }
+}
+
+void AssetLoader::queueTexture(const std::string &path)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(path);
+    }
+    m_queuedCount++;
+    m_wakeWorkers.notify_one();
+}
+
+void AssetLoader::update(std::size_t maxUploads)
+{
+    for (std::size_t i = 0; i < maxUploads; i++)
+    {
+        DecodedImage decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty())
+            {
+                return;
+            }
+            decoded = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        // GPU upload must stay on the thread that owns the GL context
+        if (!decoded.loaded || !m_resources.addTexture(decoded.path, decoded.image))
+        {
+            std::cerr << "Error loading texture: " << decoded.path << std::endl;
+        }
+
+        m_finishedCount++;
+    }
+}
+
+float AssetLoader::getProgress() const
+{
+    return m_queuedCount == 0 ? 1.f : static_cast<float>(m_finishedCount) / static_cast<float>(m_queuedCount);
+}
+
+bool AssetLoader::isDone() const
+{
+    return m_finishedCount == m_queuedCount;
+}
@@ -0,0 +1,191 @@
+#include "core/AssetPack.hpp"
+#include "core/LittleEndian.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    using LittleEndian::readU16;
+    using LittleEndian::readU32;
+    using LittleEndian::readU64;
+}
+
+AssetPack::AssetPack()
+    : m_data(nullptr),
+      m_size(0),
+#ifdef _WIN32
+      m_file(nullptr),
+      m_mapping(nullptr)
+#else
+      m_file(-1)
+#endif
+{
+}
+
+AssetPack::~AssetPack()
+{
+    close();
+}
+
+bool AssetPack::open(const std::string &path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const unsigned char *>(view);
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    void *view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (view == MAP_FAILED)
+    {
+        ::close(file);
+        return false;
+    }
+
+    m_file = file;
+    m_data = static_cast<const unsigned char *>(view);
+    m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    if (!readTableOfContents())
+    {
+        std::cerr << "Invalid asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool AssetPack::readTableOfContents()
+{
+    const std::size_t headerSize = 16;
+    if (m_size < headerSize || std::memcmp(m_data, PackFormat::MAGIC, 8) != 0 ||
+        readU32(m_data + 8) != PackFormat::VERSION)
+    {
+        return false;
+    }
+
+    std::uint32_t entryCount = readU32(m_data + 12);
+    std::size_t cursor = headerSize;
+
+    for (std::uint32_t i = 0; i < entryCount; i++)
+    {
+        if (cursor + 18 > m_size)
+            return false;
+
+        std::uint64_t offset = readU64(m_data + cursor);
+        std::uint64_t size = readU64(m_data + cursor + 8);
+        std::uint16_t pathLength = readU16(m_data + cursor + 16);
+        cursor += 18;
+
+        if (cursor + pathLength > m_size || offset > m_size || size > m_size - offset)
+            return false;
+
+        std::string path(reinterpret_cast<const char *>(m_data + cursor), pathLength);
+        cursor += pathLength;
+
+        m_entries[path] = {m_data + offset, static_cast<std::size_t>(size)};
+    }
+    return true;
+}
+
+void AssetPack::close()
+{
+    m_entries.clear();
+
+#ifdef _WIN32
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file)
+        CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data)
+        munmap(const_cast<unsigned char *>(m_data), m_size);
+    if (m_file >= 0)
+        ::close(m_file);
+    m_file = -1;
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool AssetPack::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+std::optional<AssetPack::Blob> AssetPack::find(const std::string &path) const
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end() && path.find('\\') != std::string::npos)
+    {
+        // paths joined with std::filesystem on Windows use backslashes
+        std::string normalized = path;
+        std::replace(normalized.begin(), normalized.end(), '\\', '/');
+        it = m_entries.find(normalized);
+    }
+
+    if (it == m_entries.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::size_t AssetPack::getEntryCount() const
+{
+    return m_entries.size();
+}
@@ -0,0 +1,171 @@
+#include "core/JobSystem.hpp"
+#include "core/Tracer.hpp"
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned int threadCount)
+    : m_queues(threadCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threadCount),
+      m_invoke(nullptr),
+      m_body(nullptr),
+      m_remainingJobs(0),
+      m_queuedJobs(0),
+      m_stopping(false)
+{
+    for (unsigned int thread = 1; thread < m_queues.size(); thread++)
+    {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, thread);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeWorkers.notify_all();
+
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+unsigned int JobSystem::getThreadCount() const
+{
+    return static_cast<unsigned int>(m_queues.size());
+}
+
+void JobSystem::workerLoop(unsigned int thread)
+{
+    Tracer::setThreadName("job worker");
+
+    while (true)
+    {
+        Job job;
+        if (popJob(thread, job) || stealJob(thread, job))
+        {
+            runJob(job, thread);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeWorkers.wait(lock, [this]()
+                           { return m_stopping || m_queuedJobs.load() > 0; });
+        if (m_stopping)
+        {
+            return;
+        }
+    }
+}
+
+bool JobSystem::popJob(unsigned int thread, Job &job)
+{
+    Queue &queue = m_queues[thread];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.jobs.size())
+    {
+        return false;
+    }
+
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    if (queue.head == queue.jobs.size())
+    {
+        queue.jobs.clear();
+        queue.head = 0;
+    }
+
+    m_queuedJobs--;
+    return true;
+}
+
+bool JobSystem::stealJob(unsigned int thread, Job &job)
+{
+    for (std::size_t offset = 1; offset < m_queues.size(); offset++)
+    {
+        Queue &victim = m_queues[(thread + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.head == victim.jobs.size())
+        {
+            continue;
+        }
+
+        job = victim.jobs[victim.head++];
+        if (victim.head == victim.jobs.size())
+        {
+            victim.jobs.clear();
+            victim.head = 0;
+        }
+
+        m_queuedJobs--;
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::runJob(const Job &job, unsigned int thread)
+{
+    TRACE_ZONE("job");
+    m_invoke(m_body, job.begin, job.end, thread);
+    m_remainingJobs.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::run(std::size_t count, std::size_t grain, Invoke invoke, const void *body)
+{
+    grain = std::max<std::size_t>(grain, 1);
+
+    // not worth waking anyone for a single chunk
+    if (count <= grain || m_queues.size() == 1)
+    {
+        if (count > 0)
+        {
+            invoke(body, 0, count, 0);
+        }
+        return;
+    }
+
+    std::size_t jobCount = (count + grain - 1) / grain;
+    m_invoke = invoke;
+    m_body = body;
+    m_remainingJobs.store(jobCount, std::memory_order_relaxed);
+
+    // counted before queueing, so a fast pop never takes the counter below zero
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queuedJobs += jobCount;
+    }
+
+    // deal contiguous runs of chunks to each queue, so neighbouring entities
+    // stay on one thread unless someone has to steal
+    std::size_t perQueue = (jobCount + m_queues.size() - 1) / m_queues.size();
+    for (std::size_t q = 0; q < m_queues.size(); q++)
+    {
+        Queue &queue = m_queues[q];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        std::size_t firstJob = q * perQueue;
+        std::size_t lastJob = std::min(jobCount, firstJob + perQueue);
+        // pushed in reverse so the owner pops them front to back
+        for (std::size_t j = lastJob; j > firstJob; j--)
+        {
+            std::size_t begin = (j - 1) * grain;
+            queue.jobs.push_back({begin, std::min(count, begin + grain)});
+        }
+    }
+
+    m_wakeWorkers.notify_all();
+
+    // help out until every chunk has finished, not just until the queues are empty
+    while (m_remainingJobs.load(std::memory_order_acquire) > 0)
+    {
+        Job job;
+        if (popJob(0, job) || stealJob(0, job))
+        {
+            runJob(job, 0);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
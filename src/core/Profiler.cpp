@@ -0,0 +1,136 @@
+#include "core/Profiler.hpp"
+#include "core/Tracer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+namespace
+{
+    // Written by one thread only (each zone runs on one thread), read by the
+    // overlay on the render thread. Relaxed atomics are enough: the overlay
+    // may see a sample from this frame or the last, never a torn value, and
+    // recording costs no lock.
+    struct History
+    {
+        std::array<std::atomic<float>, Profiler::HISTORY_SIZE> samples{};
+        std::atomic<std::size_t> recorded{0};
+
+        void push(float milliseconds)
+        {
+            std::size_t count = recorded.load(std::memory_order_relaxed);
+            samples[count % samples.size()].store(milliseconds, std::memory_order_relaxed);
+            recorded.store(count + 1, std::memory_order_release);
+        }
+
+        // oldest first
+        void copy(std::vector<float> &out) const
+        {
+            std::size_t count = recorded.load(std::memory_order_acquire);
+            std::size_t first = count > samples.size() ? count - samples.size() : 0;
+
+            out.clear();
+            for (std::size_t i = first; i < count; i++)
+            {
+                out.push_back(samples[i % samples.size()].load(std::memory_order_relaxed));
+            }
+        }
+    };
+
+    std::array<History, static_cast<std::size_t>(ProfileZone::Count)> zoneHistories;
+    History frameHistory;
+
+    // summaries only ever run on the render thread
+    std::vector<float> sortScratch;
+
+    Profiler::Summary summarizeHistory(const History &history)
+    {
+        history.copy(sortScratch);
+        if (sortScratch.empty())
+        {
+            return {0.f, 0.f, 0.f};
+        }
+
+        float last = sortScratch.back();
+        std::sort(sortScratch.begin(), sortScratch.end());
+
+        auto percentile = [](float p)
+        {
+            std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<float>(sortScratch.size())));
+            return sortScratch[std::clamp<std::size_t>(rank, 1, sortScratch.size()) - 1];
+        };
+
+        return {last, percentile(0.5f), percentile(0.99f)};
+    }
+}
+
+namespace Profiler
+{
+    const char *getZoneName(ProfileZone zone)
+    {
+        switch (zone)
+        {
+        case ProfileZone::Events:
+            return "events";
+        case ProfileZone::Input:
+            return "input";
+        case ProfileZone::Physics:
+            return "physics";
+        case ProfileZone::Animation:
+            return "animation";
+        case ProfileZone::GroundDraw:
+            return "ground draw";
+        case ProfileZone::Particles:
+            return "particles";
+        case ProfileZone::Display:
+            return "display";
+        default:
+            return "?";
+        }
+    }
+
+    void record(ProfileZone zone, float milliseconds)
+    {
+        zoneHistories[static_cast<std::size_t>(zone)].push(milliseconds);
+    }
+
+    void recordFrame(float milliseconds)
+    {
+        frameHistory.push(milliseconds);
+    }
+
+    Summary summarize(ProfileZone zone)
+    {
+        return summarizeHistory(zoneHistories[static_cast<std::size_t>(zone)]);
+    }
+
+    Summary summarizeFrames()
+    {
+        return summarizeHistory(frameHistory);
+    }
+
+    void copyFrameTimes(std::vector<float> &out)
+    {
+        frameHistory.copy(out);
+    }
+}
+
+ProfileScope::ProfileScope(ProfileZone zone)
+    : m_zone(zone),
+      m_traced(Tracer::isEnabled())
+{
+    if (m_traced)
+    {
+        Tracer::begin(Profiler::getZoneName(zone));
+    }
+    m_start = std::chrono::steady_clock::now();
+}
+
+ProfileScope::~ProfileScope()
+{
+    Profiler::record(m_zone, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+    if (m_traced)
+    {
+        Tracer::end(Profiler::getZoneName(m_zone));
+    }
+}
@@ -0,0 +1,19 @@
+#include "core/RenderStats.hpp"
+
+namespace RenderStats
+{
+    std::size_t drawCalls = 0;
+    std::size_t vertices = 0;
+
+    void reset()
+    {
+        drawCalls = 0;
+        vertices = 0;
+    }
+
+    void addDrawCall(std::size_t vertexCount)
+    {
+        drawCalls++;
+        vertices += vertexCount;
+    }
+}
@@ -0,0 +1,213 @@
+#include "core/ResourceManager.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+
+bool ResourceManager::mountPack(const std::string &path)
+{
+    return m_pack.open(path);
+}
+
+bool ResourceManager::hasPack() const
+{
+    return m_pack.isOpen();
+}
+
+std::optional<AssetPack::Blob> ResourceManager::findInPack(const std::string &path) const
+{
+    return m_pack.find(path);
+}
+
+TextureHandle ResourceManager::getTexture(const std::string &path)
+{
+    auto it = m_textures.find(path);
+    if (it != m_textures.end())
+    {
+        return it->second;
+    }
+
+    auto texture = std::make_shared<sf::Texture>();
+    std::optional<AssetPack::Blob> blob = m_pack.find(path);
+    bool loaded = blob ? texture->loadFromMemory(blob->data, blob->size) : texture->loadFromFile(path);
+    if (!loaded)
+    {
+        std::cerr << "Error loading texture: " << path << std::endl;
+        return nullptr;
+    }
+
+    m_textures.emplace(path, texture);
+    return texture;
+}
+
+TextureHandle ResourceManager::addTexture(const std::string &path, const sf::Image &image)
+{
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(image))
+    {
+        return nullptr;
+    }
+
+    m_textures[path] = texture;
+    return texture;
+}
+
+bool ResourceManager::setTextureRepeated(const std::string &path, bool repeated)
+{
+    auto it = m_textures.find(path);
+    if (it == m_textures.end())
+    {
+        return false;
+    }
+
+    it->second->setRepeated(repeated);
+    return true;
+}
+
+FontHandle ResourceManager::getFont(const std::string &path)
+{
+    auto it = m_fonts.find(path);
+    if (it != m_fonts.end())
+    {
+        return it->second;
+    }
+
+    // sf::Font streams glyphs from its source, the pack mapping stays valid
+    // for as long as this manager exists
+    auto font = std::make_shared<sf::Font>();
+    std::optional<AssetPack::Blob> blob = m_pack.find(path);
+    bool opened = blob ? font->openFromMemory(blob->data, blob->size) : font->openFromFile(path);
+    if (!opened)
+    {
+        std::cerr << "Error loading font: " << path << std::endl;
+        return nullptr;
+    }
+
+    std::size_t fileSize = 0;
+    if (blob)
+    {
+        fileSize = blob->size;
+    }
+    else
+    {
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(path, error);
+        fileSize = error ? 0 : static_cast<std::size_t>(size);
+    }
+
+    m_fonts.emplace(path, font);
+    m_fontFileSizes[path] = fileSize;
+    return font;
+}
+
+SoundBufferHandle ResourceManager::getSoundBuffer(const std::string &path)
+{
+    auto it = m_soundBuffers.find(path);
+    if (it != m_soundBuffers.end())
+    {
+        return it->second;
+    }
+
+    auto buffer = std::make_shared<sf::SoundBuffer>();
+    std::optional<AssetPack::Blob> blob = m_pack.find(path);
+    bool loaded = blob ? buffer->loadFromMemory(blob->data, blob->size) : buffer->loadFromFile(path);
+    if (!loaded)
+    {
+        std::cerr << "Error loading sound: " << path << std::endl;
+        return nullptr;
+    }
+
+    m_soundBuffers.emplace(path, buffer);
+    return buffer;
+}
+
+void ResourceManager::releaseUnused()
+{
+    for (auto it = m_textures.begin(); it != m_textures.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            it = m_textures.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto it = m_fonts.begin(); it != m_fonts.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            m_fontFileSizes.erase(it->first);
+            it = m_fonts.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto it = m_soundBuffers.begin(); it != m_soundBuffers.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            it = m_soundBuffers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::size_t ResourceManager::getTextureCount() const
+{
+    return m_textures.size();
+}
+
+std::size_t ResourceManager::getFontCount() const
+{
+    return m_fonts.size();
+}
+
+std::size_t ResourceManager::getSoundBufferCount() const
+{
+    return m_soundBuffers.size();
+}
+
+std::size_t ResourceManager::getResidentBytes() const
+{
+    std::size_t bytes = 0;
+
+    for (const auto &[path, texture] : m_textures)
+    {
+        sf::Vector2u size = texture->getSize();
+        bytes += static_cast<std::size_t>(size.x) * size.y * 4;
+    }
+
+    for (const auto &[path, fileSize] : m_fontFileSizes)
+    {
+        bytes += fileSize;
+    }
+
+    for (const auto &[path, buffer] : m_soundBuffers)
+    {
+        bytes += static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(std::int16_t);
+    }
+
+    return bytes;
+}
+
+void ResourceManager::printReport(std::ostream &out) const
+{
+    out << "Resources: " << m_textures.size() << " textures, " << m_fonts.size() << " fonts, "
+        << m_soundBuffers.size() << " sounds, "
+        << getResidentBytes() / 1024 << " KiB resident" << std::endl;
+
+    for (const auto &[path, texture] : m_textures)
+    {
+        sf::Vector2u size = texture->getSize();
+        out << "  " << path << " (" << size.x << "x" << size.y << ", "
+            << texture.use_count() - 1 << " handles)" << std::endl;
+    }
+}
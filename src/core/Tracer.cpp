@@ -0,0 +1,204 @@
+#include "core/Tracer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char *name;
+        std::int64_t time; // steady clock, nanoseconds
+        char phase;        // 'B' or 'E'
+    };
+
+    // Written by its thread only. The count is published with release
+    // ordering, so the writer sees every event below it; a buffer left over
+    // from an earlier capture is reset by its own thread on the next event.
+    struct ThreadBuffer
+    {
+        std::vector<TraceEvent> events;
+        std::atomic<std::size_t> count{0};
+        std::atomic<std::uint32_t> capture{0};
+        std::atomic<std::size_t> dropped{0};
+        std::atomic<const char *> name{nullptr};
+        std::uint32_t id = 0;
+    };
+
+    std::atomic<std::uint32_t> currentCapture{0};
+    std::atomic<std::int64_t> captureStart{0};
+
+    // buffers are only ever added, threads keep a pointer to theirs
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    thread_local ThreadBuffer *threadBuffer = nullptr;
+    thread_local const char *threadName = nullptr;
+
+    std::int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // first event on a thread allocates its buffer, not before tracing is on
+    ThreadBuffer &getThreadBuffer()
+    {
+        if (!threadBuffer)
+        {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->events.resize(Tracer::THREAD_CAPACITY);
+            buffer->name.store(threadName, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffer->id = static_cast<std::uint32_t>(buffers.size() + 1);
+            threadBuffer = buffer.get();
+            buffers.push_back(std::move(buffer));
+        }
+        return *threadBuffer;
+    }
+
+    void push(const char *name, char phase)
+    {
+        ThreadBuffer &buffer = getThreadBuffer();
+
+        std::uint32_t capture = currentCapture.load(std::memory_order_acquire);
+        if (buffer.capture.load(std::memory_order_relaxed) != capture)
+        {
+            buffer.count.store(0, std::memory_order_relaxed);
+            buffer.dropped.store(0, std::memory_order_relaxed);
+            buffer.capture.store(capture, std::memory_order_release);
+        }
+
+        std::size_t count = buffer.count.load(std::memory_order_relaxed);
+        if (count == buffer.events.size())
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.events[count] = {name, now(), phase};
+        buffer.count.store(count + 1, std::memory_order_release);
+    }
+
+    // JSON string body; names are literals, but keep the file valid anyway
+    void writeEscaped(std::ostream &out, const char *text)
+    {
+        for (const char *c = text; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                out << '\\';
+            }
+            out << *c;
+        }
+    }
+}
+
+namespace Tracer
+{
+    std::atomic<bool> enabled{false};
+
+    void setThreadName(const char *name)
+    {
+        threadName = name;
+        if (threadBuffer)
+        {
+            threadBuffer->name.store(name, std::memory_order_relaxed);
+        }
+    }
+
+    void start()
+    {
+        captureStart.store(now(), std::memory_order_relaxed);
+        currentCapture.fetch_add(1, std::memory_order_release);
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void stop()
+    {
+        enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void begin(const char *name)
+    {
+        push(name, 'B');
+    }
+
+    void end(const char *name)
+    {
+        push(name, 'E');
+    }
+
+    bool writeJson(const std::string &path)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            std::cerr << "Error: cannot write trace to " << path << std::endl;
+            return false;
+        }
+
+        std::uint32_t capture = currentCapture.load(std::memory_order_acquire);
+        std::int64_t start = captureStart.load(std::memory_order_relaxed);
+        std::size_t written = 0, dropped = 0;
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << std::fixed << std::setprecision(3);
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        bool first = true;
+        for (const std::unique_ptr<ThreadBuffer> &buffer : buffers)
+        {
+            if (buffer->capture.load(std::memory_order_acquire) != capture)
+            {
+                continue;
+            }
+
+            if (const char *name = buffer->name.load(std::memory_order_relaxed))
+            {
+                out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                    << ",\"args\":{\"name\":\"";
+                writeEscaped(out, name);
+                out << "\"}}";
+                first = false;
+            }
+
+            // an end whose begin came before the capture started has nothing
+            // to close, leave it out
+            std::size_t count = buffer->count.load(std::memory_order_acquire);
+            int depth = 0;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const TraceEvent &event = buffer->events[i];
+                if (event.phase == 'E' && depth == 0)
+                {
+                    continue;
+                }
+                depth += event.phase == 'B' ? 1 : -1;
+
+                out << (first ? "" : ",\n") << "{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << static_cast<double>(event.time - start) / 1000.0
+                    << ",\"pid\":1,\"tid\":" << buffer->id << "}";
+                first = false;
+                written++;
+            }
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+
+        out << "\n]}\n";
+
+        std::cout << "Trace written to " << path << " (" << written << " events";
+        if (dropped > 0)
+        {
+            std::cout << ", " << dropped << " dropped";
+        }
+        std::cout << ")" << std::endl;
+        return static_cast<bool>(out);
+    }
+}
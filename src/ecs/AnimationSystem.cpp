@@ -0,0 +1,52 @@
+#include "ecs/AnimationSystem.hpp"
+#include "core/Profiler.hpp"
+
+// entities per job, stepping a clip is cheap
+static const std::size_t ANIMATION_GRAIN = 1024;
+
+void AnimationSystem::update(Registry &registry, float deltaTime, JobSystem *jobs)
+{
+    PROFILE_ZONE(ProfileZone::Animation);
+
+    parallelFor(jobs, registry.size(), ANIMATION_GRAIN, [&](std::size_t begin, std::size_t end, unsigned int)
+                { updateRange(registry.animations, deltaTime, begin, end); });
+}
+
+void AnimationSystem::updateRange(AnimationPool &pool, float deltaTime, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; i++)
+    {
+        const AnimationClip *clip = pool.clip[i];
+        pool.finished[i] = 0;
+        if (!clip)
+        {
+            continue;
+        }
+
+        pool.timer[i] += deltaTime;
+        if (pool.timer[i] < clip->frames[pool.frame[i]].duration)
+        {
+            continue;
+        }
+
+        pool.timer[i] = 0.f;
+        pool.frame[i]++;
+
+        if (pool.frame[i] >= clip->frames.size())
+        {
+            pool.frame[i] = 0;
+            pool.finished[i] = !clip->loop;
+        }
+
+        pool.events[i] = clip->frames[pool.frame[i]].events;
+    }
+}
+
+void AnimationSystem::play(Registry &registry, std::size_t index, const AnimationClip *clip)
+{
+    AnimationPool &pool = registry.animations;
+    pool.clip[index] = clip;
+    pool.frame[index] = 0;
+    pool.timer[index] = 0.f;
+    pool.events[index] = clip ? clip->frames[0].events : 0;
+}
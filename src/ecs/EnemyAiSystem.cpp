@@ -0,0 +1,64 @@
+#include "ecs/EnemyAiSystem.hpp"
+#include "ecs/AnimationSystem.hpp"
+#include <cmath>
+#include <iostream>
+
+// close enough to swing, stop walking
+static const float STOP_DISTANCE = 30.f;
+
+// entities per job
+static const std::size_t AI_GRAIN = 1024;
+
+EnemyAiSystem::EnemyAiSystem()
+    : m_idleClip(nullptr),
+      m_runClip(nullptr)
+{
+}
+
+void EnemyAiSystem::setAnimations(std::shared_ptr<const AnimationLibrary> animations)
+{
+    const AnimationClip *idle = animations ? animations->findClip("idle") : nullptr;
+    const AnimationClip *run = animations ? animations->findClip("run") : nullptr;
+    if (!idle || !run)
+    {
+        std::cerr << "Error: enemy animations need idle and run clips!" << std::endl;
+        return;
+    }
+
+    m_animations = std::move(animations);
+    m_idleClip = idle;
+    m_runClip = run;
+}
+
+void EnemyAiSystem::update(Registry &registry, sf::Vector2f target, JobSystem *jobs)
+{
+    parallelFor(jobs, registry.size(), AI_GRAIN, [&](std::size_t begin, std::size_t end, unsigned int)
+                { updateRange(registry, target, begin, end); });
+}
+
+void EnemyAiSystem::updateRange(Registry &registry, sf::Vector2f target, std::size_t begin, std::size_t end) const
+{
+    for (std::size_t i = begin; i < end; i++)
+    {
+        if (registry.ai.kind[i] != AiKind::Chase)
+        {
+            continue;
+        }
+
+        float distanceX = target.x - registry.transforms.position[i].x;
+        bool chasing = std::abs(distanceX) <= registry.ai.aggroRange[i] && std::abs(distanceX) > STOP_DISTANCE;
+
+        float &velocityX = registry.velocities.velocity[i].x;
+        velocityX = chasing ? std::copysign(registry.ai.speed[i], distanceX) : 0.f;
+        if (chasing)
+        {
+            registry.animations.facingRight[i] = distanceX > 0.f;
+        }
+
+        const AnimationClip *clip = chasing ? m_runClip : m_idleClip;
+        if (registry.animations.clip[i] != clip)
+        {
+            AnimationSystem::play(registry, i, clip);
+        }
+    }
+}
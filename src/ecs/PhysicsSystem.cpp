@@ -0,0 +1,77 @@
+#include "ecs/PhysicsSystem.hpp"
+#include "core/Profiler.hpp"
+#include "physics/SweptAabb.hpp"
+#include <algorithm>
+#include <cmath>
+
+// entities per job, a few microseconds of work each
+static const std::size_t PHYSICS_GRAIN = 256;
+
+void PhysicsSystem::update(Registry &registry, const Ground &ground, float deltaTime, JobSystem *jobs)
+{
+    PROFILE_ZONE(ProfileZone::Physics);
+
+    // any lazy rebuild has to happen before threads start querying
+    ground.updateCollision();
+
+    m_scratch.resize(jobs ? jobs->getThreadCount() : 1);
+
+    parallelFor(jobs, registry.size(), PHYSICS_GRAIN, [&](std::size_t begin, std::size_t end, unsigned int thread)
+                { updateRange(registry, ground, deltaTime, begin, end, m_scratch[thread].nearbyBoxes); });
+}
+
+void PhysicsSystem::updateRange(Registry &registry, const Ground &ground, float deltaTime,
+                                std::size_t begin, std::size_t end, std::vector<sf::FloatRect> &nearbyBoxes) const
+{
+    std::vector<sf::Vector2f> &positions = registry.transforms.position;
+    std::vector<sf::Vector2f> &previousPositions = registry.transforms.previousPosition;
+    std::vector<sf::Vector2f> &velocities = registry.velocities.velocity;
+    const std::vector<float> &gravities = registry.velocities.gravity;
+    const std::vector<sf::FloatRect> &localBoxes = registry.colliders.localBox;
+    std::vector<std::uint8_t> &onGround = registry.colliders.onGround;
+
+    for (std::size_t i = begin; i < end; i++)
+    {
+        sf::Vector2f &position = positions[i];
+        sf::Vector2f &velocity = velocities[i];
+        const sf::FloatRect &localBox = localBoxes[i];
+
+        previousPositions[i] = position;
+
+        // Apply gravity
+        sf::Vector2f newVelocity(velocity.x, velocity.y + gravities[i] * deltaTime);
+
+        // Only test ground boxes around the path covered this step
+        sf::FloatRect startBounds({position.x + localBox.position.x, position.y + localBox.position.y}, localBox.size);
+        sf::Vector2f travel = newVelocity * deltaTime;
+        sf::FloatRect sweptBounds(
+            {startBounds.position.x + std::min(travel.x, 0.f), startBounds.position.y + std::min(travel.y, 0.f)},
+            {startBounds.size.x + std::abs(travel.x), startBounds.size.y + std::abs(travel.y)});
+
+        // streamed ground not in yet: hold the body still rather than let
+        // it fall through the missing tiles
+        if (!ground.isLoaded(sweptBounds))
+        {
+            continue;
+        }
+        velocity = newVelocity;
+
+        nearbyBoxes.clear();
+        ground.queryRegion(sweptBounds, nearbyBoxes);
+
+        // swept against the whole path, so a fast body stops at the first
+        // face it reaches instead of stepping over thin ground
+        SlideResult moved = sweepAndSlide(startBounds, travel, nearbyBoxes);
+        position = moved.box.position - localBox.position;
+
+        if (moved.hitWall)
+        {
+            velocity.x = 0.f;
+        }
+        if (moved.hitFloor || moved.hitCeiling)
+        {
+            velocity.y = 0.f;
+        }
+        onGround[i] = moved.hitFloor;
+    }
+}
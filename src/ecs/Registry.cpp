@@ -0,0 +1,87 @@
+#include "ecs/Registry.hpp"
+
+Entity Registry::create(sf::Vector2f position)
+{
+    std::uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(m_generations.size());
+        m_generations.push_back(0);
+        m_denseIndex.push_back(0);
+    }
+
+    Entity entity{slot, m_generations[slot]};
+    m_denseIndex[slot] = static_cast<std::uint32_t>(m_entities.size());
+    m_entities.push_back(entity);
+
+    forEachColumn([](auto &column)
+                  { column.emplace_back(); });
+
+    std::size_t index = m_entities.size() - 1;
+    transforms.position[index] = position;
+    transforms.previousPosition[index] = position;
+    animations.clip[index] = nullptr;
+    animations.facingRight[index] = 1;
+    ai.kind[index] = AiKind::None;
+
+    return entity;
+}
+
+void Registry::destroy(Entity entity)
+{
+    if (!isAlive(entity))
+    {
+        return;
+    }
+
+    // move the last entity into the hole, keeping every column packed
+    std::size_t index = m_denseIndex[entity.slot];
+    std::size_t last = m_entities.size() - 1;
+
+    forEachColumn([index, last](auto &column)
+                  {
+        column[index] = column[last];
+        column.pop_back(); });
+
+    m_entities[index] = m_entities[last];
+    m_entities.pop_back();
+    if (index != last)
+    {
+        m_denseIndex[m_entities[index].slot] = static_cast<std::uint32_t>(index);
+    }
+
+    m_generations[entity.slot]++;
+    m_freeSlots.push_back(entity.slot);
+}
+
+bool Registry::isAlive(Entity entity) const
+{
+    return entity.slot < m_generations.size() && m_generations[entity.slot] == entity.generation;
+}
+
+std::size_t Registry::indexOf(Entity entity) const
+{
+    return m_denseIndex[entity.slot];
+}
+
+Entity Registry::entityAt(std::size_t index) const
+{
+    return m_entities[index];
+}
+
+std::size_t Registry::size() const
+{
+    return m_entities.size();
+}
+
+void Registry::reserve(std::size_t count)
+{
+    m_entities.reserve(count);
+    forEachColumn([count](auto &column)
+                  { column.reserve(count); });
+}
@@ -0,0 +1,98 @@
+#include "graphics/ActorRenderer.hpp"
+#include "core/RenderStats.hpp"
+#include <utility>
+
+void ActorRenderer::setAtlas(std::shared_ptr<const SpriteAtlas> atlas)
+{
+    m_atlas = std::move(atlas);
+    m_batches.assign(m_atlas ? m_atlas->getPagePaths().size() : 0, sf::VertexArray(sf::PrimitiveType::Triangles));
+}
+
+void ActorRenderer::capture(const Registry &registry, const sf::FloatRect &region, std::vector<SpriteInstance> &out) const
+{
+    if (!m_atlas || !m_atlas->isLoaded())
+    {
+        return;
+    }
+
+    const AnimationPool &animations = registry.animations;
+
+    for (std::size_t i = 0; i < registry.size(); i++)
+    {
+        const AnimationClip *clip = animations.clip[i];
+        if (!clip)
+        {
+            continue;
+        }
+
+        const AtlasFrame &frame = m_atlas->getFrame(clip->frames[animations.frame[i]].atlasFrame);
+        sf::Vector2f size(static_cast<float>(frame.rect.size.x), static_cast<float>(frame.rect.size.y));
+        sf::Vector2f position = registry.transforms.position[i];
+        if (size.x == 0.f || !region.findIntersection(sf::FloatRect(position - size / 2.f, size)))
+        {
+            continue;
+        }
+
+        out.push_back({registry.transforms.previousPosition[i], position, frame.rect, frame.page, !animations.facingRight[i]});
+    }
+}
+
+void ActorRenderer::draw(sf::RenderWindow &window, const sf::View &view, const std::vector<SpriteInstance> &sprites, float alpha)
+{
+    if (!m_atlas || !m_atlas->isLoaded())
+    {
+        return;
+    }
+
+    for (sf::VertexArray &batch : m_batches)
+    {
+        batch.clear();
+    }
+
+    sf::FloatRect viewBounds(view.getCenter() - view.getSize() / 2.f, view.getSize());
+
+    for (const SpriteInstance &sprite : sprites)
+    {
+        sf::Vector2f size(static_cast<float>(sprite.textureRect.size.x), static_cast<float>(sprite.textureRect.size.y));
+
+        // sprites are centred on the entity position
+        sf::Vector2f center = sprite.previousPosition + (sprite.position - sprite.previousPosition) * alpha;
+        sf::FloatRect bounds(center - size / 2.f, size);
+        if (!viewBounds.findIntersection(bounds))
+        {
+            continue;
+        }
+
+        // flip horizontally when facing left by swapping the texture edges
+        float left = static_cast<float>(sprite.textureRect.position.x);
+        float right = left + size.x;
+        if (sprite.flipped)
+        {
+            std::swap(left, right);
+        }
+        float top = static_cast<float>(sprite.textureRect.position.y);
+        float bottom = top + size.y;
+
+        sf::Vector2f topLeft = bounds.position;
+        sf::Vector2f bottomRight = bounds.position + size;
+
+        sf::VertexArray &batch = m_batches[sprite.page];
+        batch.append(sf::Vertex{topLeft, sf::Color::White, {left, top}});
+        batch.append(sf::Vertex{{bottomRight.x, topLeft.y}, sf::Color::White, {right, top}});
+        batch.append(sf::Vertex{{topLeft.x, bottomRight.y}, sf::Color::White, {left, bottom}});
+        batch.append(sf::Vertex{{topLeft.x, bottomRight.y}, sf::Color::White, {left, bottom}});
+        batch.append(sf::Vertex{{bottomRight.x, topLeft.y}, sf::Color::White, {right, top}});
+        batch.append(sf::Vertex{bottomRight, sf::Color::White, {right, bottom}});
+    }
+
+    for (std::size_t page = 0; page < m_batches.size(); page++)
+    {
+        if (m_batches[page].getVertexCount() == 0)
+        {
+            continue;
+        }
+
+        window.draw(m_batches[page], m_atlas->getPage(static_cast<std::uint16_t>(page)).get());
+        RenderStats::addDrawCall(m_batches[page].getVertexCount());
+    }
+}
@@ -0,0 +1,171 @@
+#include "graphics/AnimationClip.hpp"
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+namespace
+{
+    // "3" or "3-5", inclusive
+    bool parseRange(const std::string &text, std::uint32_t &first, std::uint32_t &last)
+    {
+        char dash = 0;
+        std::istringstream fields(text);
+        if (!(fields >> first))
+            return false;
+        last = first;
+        if (fields >> dash && (dash != '-' || !(fields >> last)))
+            return false;
+        return first <= last;
+    }
+
+    bool parseEvent(const std::string &name, std::uint32_t &flag)
+    {
+        if (name == "hitbox")
+        {
+            flag = AnimationEvent::HITBOX;
+            return true;
+        }
+        return false;
+    }
+}
+
+AnimationLibrary::AnimationLibrary()
+    : m_bound(false)
+{
+}
+
+bool AnimationLibrary::loadFromFile(const std::string &path, const ResourceManager &resources)
+{
+    std::optional<AssetPack::Blob> blob = resources.findInPack(path);
+    if (blob)
+    {
+        BlobStreamBuffer buffer(*blob);
+        std::istream in(&buffer);
+        return readClips(in, path);
+    }
+
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Error opening animation clips: " << path << std::endl;
+        return false;
+    }
+    return readClips(in, path);
+}
+
+bool AnimationLibrary::readClips(std::istream &in, const std::string &path)
+{
+    std::unordered_map<std::string, AnimationClip> clips;
+    AnimationClip *clip = nullptr;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword) || keyword[0] == '#')
+        {
+            continue;
+        }
+
+        bool valid = false;
+        if (keyword == "clip")
+        {
+            std::string name, sequence, mode;
+            if (fields >> name >> sequence >> mode && (mode == "loop" || mode == "once"))
+            {
+                clip = &clips[name];
+                *clip = {sequence, mode == "loop", {}};
+                valid = true;
+            }
+        }
+        else if (keyword == "frames" && clip)
+        {
+            std::string range;
+            std::uint32_t first = 0, last = 0;
+            float duration = 0.f;
+            if (fields >> range >> duration && parseRange(range, first, last) && duration > 0.f)
+            {
+                for (std::uint32_t cell = first; cell <= last; cell++)
+                {
+                    clip->frames.push_back({cell, 0, duration, 0});
+                }
+                valid = true;
+            }
+        }
+        else if (keyword == "event" && clip)
+        {
+            std::string name, range;
+            std::uint32_t first = 0, last = 0, flag = 0;
+            if (fields >> name >> range && parseEvent(name, flag) && parseRange(range, first, last) &&
+                last < clip->frames.size())
+            {
+                for (std::uint32_t frame = first; frame <= last; frame++)
+                {
+                    clip->frames[frame].events |= flag;
+                }
+                valid = true;
+            }
+        }
+
+        if (!valid)
+        {
+            std::cerr << "Invalid animation clip line " << lineNumber << " in: " << path << std::endl;
+            return false;
+        }
+    }
+
+    for (const auto &[name, parsed] : clips)
+    {
+        if (parsed.frames.empty())
+        {
+            std::cerr << "Animation clip '" << name << "' has no frames in: " << path << std::endl;
+            return false;
+        }
+    }
+
+    m_clips = std::move(clips);
+    m_bound = false;
+    return true;
+}
+
+bool AnimationLibrary::bind(const SpriteAtlas &atlas)
+{
+    for (auto &[name, clip] : m_clips)
+    {
+        const AtlasSequence *sequence = atlas.findSequence(clip.sequence);
+        if (!sequence)
+        {
+            std::cerr << "Atlas has no sequence '" << clip.sequence << "' for clip: " << name << std::endl;
+            return false;
+        }
+
+        for (AnimationFrame &frame : clip.frames)
+        {
+            if (frame.cell >= sequence->frameCount)
+            {
+                std::cerr << "Clip '" << name << "' frame " << frame.cell << " is outside " << clip.sequence << std::endl;
+                return false;
+            }
+            frame.atlasFrame = sequence->firstFrame + frame.cell;
+        }
+    }
+
+    m_bound = true;
+    return true;
+}
+
+const AnimationClip *AnimationLibrary::findClip(const std::string &name) const
+{
+    auto it = m_clips.find(name);
+    return it == m_clips.end() ? nullptr : &it->second;
+}
+
+bool AnimationLibrary::isBound() const
+{
+    return m_bound;
+}
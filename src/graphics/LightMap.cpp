@@ -0,0 +1,143 @@
+#include "graphics/LightMap.hpp"
+#include "core/RenderStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+LightMap::LightMap()
+    : m_screenSize(0, 0),
+      m_resolutionScale(1.f),
+      m_targetSize(0, 0),
+      m_ambient(sf::Color::White),
+      m_visibleLights(0)
+{
+}
+
+void LightMap::setScreenSize(sf::Vector2u screenSize)
+{
+    m_screenSize = screenSize;
+}
+
+void LightMap::setResolutionScale(float scale)
+{
+    m_resolutionScale = std::min(std::max(scale, 0.05f), 1.f);
+}
+
+float LightMap::getResolutionScale() const
+{
+    return m_resolutionScale;
+}
+
+void LightMap::setAmbient(sf::Color ambient)
+{
+    m_ambient = ambient;
+}
+
+std::size_t LightMap::getVisibleLightCount() const
+{
+    return m_visibleLights;
+}
+
+bool LightMap::prepare()
+{
+    // one soft round light, tinted and sized per light by its quad
+    if (m_falloff.getSize().x == 0)
+    {
+        const unsigned int size = 128;
+        sf::Image image({size, size}, sf::Color::Black);
+        float half = static_cast<float>(size) / 2.f;
+        for (unsigned int y = 0; y < size; y++)
+        {
+            for (unsigned int x = 0; x < size; x++)
+            {
+                float distance = std::hypot(static_cast<float>(x) + 0.5f - half, static_cast<float>(y) + 0.5f - half) / half;
+                float falloff = std::max(1.f - distance, 0.f);
+                auto level = static_cast<std::uint8_t>(falloff * falloff * 255.f);
+                image.setPixel({x, y}, sf::Color(level, level, level));
+            }
+        }
+
+        if (!m_falloff.loadFromImage(image))
+        {
+            std::cerr << "Error creating the light falloff texture" << std::endl;
+            return false;
+        }
+        m_falloff.setSmooth(true);
+    }
+
+    sf::Vector2u targetSize(std::max(1u, static_cast<unsigned int>(std::lround(m_screenSize.x * m_resolutionScale))),
+                            std::max(1u, static_cast<unsigned int>(std::lround(m_screenSize.y * m_resolutionScale))));
+    if (targetSize != m_targetSize)
+    {
+        if (!m_target.resize(targetSize))
+        {
+            std::cerr << "Error creating a " << targetSize.x << "x" << targetSize.y << " light map" << std::endl;
+            m_targetSize = {0, 0};
+            return false;
+        }
+        // smooth, so a small map still stretches into soft light
+        m_target.setSmooth(true);
+        m_targetSize = targetSize;
+    }
+
+    return true;
+}
+
+void LightMap::draw(sf::RenderTarget &target, const sf::View &view, const std::vector<PointLight> &lights)
+{
+    m_visibleLights = 0;
+    if (m_screenSize.x == 0 || !prepare())
+    {
+        return;
+    }
+
+    sf::Vector2f viewTopLeft = view.getCenter() - view.getSize() / 2.f;
+    sf::Vector2f viewBottomRight = viewTopLeft + view.getSize();
+    sf::Vector2f falloffSize(m_falloff.getSize());
+
+    m_vertices.clear();
+    for (const PointLight &light : lights)
+    {
+        sf::Vector2f topLeft(light.position.x - light.radius, light.position.y - light.radius);
+        sf::Vector2f bottomRight(light.position.x + light.radius, light.position.y + light.radius);
+        if (bottomRight.x < viewTopLeft.x || topLeft.x > viewBottomRight.x ||
+            bottomRight.y < viewTopLeft.y || topLeft.y > viewBottomRight.y)
+        {
+            continue;
+        }
+
+        m_vertices.push_back({topLeft, light.color, {0.f, 0.f}});
+        m_vertices.push_back({{bottomRight.x, topLeft.y}, light.color, {falloffSize.x, 0.f}});
+        m_vertices.push_back({{topLeft.x, bottomRight.y}, light.color, {0.f, falloffSize.y}});
+        m_vertices.push_back({{topLeft.x, bottomRight.y}, light.color, {0.f, falloffSize.y}});
+        m_vertices.push_back({{bottomRight.x, topLeft.y}, light.color, {falloffSize.x, 0.f}});
+        m_vertices.push_back({bottomRight, light.color, falloffSize});
+        m_visibleLights++;
+    }
+
+    // accumulate: ambient, plus every light in one additive draw
+    m_target.setView(view);
+    m_target.clear(m_ambient);
+    if (!m_vertices.empty())
+    {
+        sf::RenderStates states(sf::BlendAdd);
+        states.texture = &m_falloff;
+        m_target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+        RenderStats::addDrawCall(m_vertices.size());
+    }
+    m_target.display();
+
+    // the whole map over the view, multiplied onto the scene
+    sf::Vector2f mapSize(m_targetSize);
+    const sf::Vertex quad[4] = {
+        {viewTopLeft, sf::Color::White, {0.f, 0.f}},
+        {{viewBottomRight.x, viewTopLeft.y}, sf::Color::White, {mapSize.x, 0.f}},
+        {{viewTopLeft.x, viewBottomRight.y}, sf::Color::White, {0.f, mapSize.y}},
+        {viewBottomRight, sf::Color::White, mapSize},
+    };
+
+    sf::RenderStates states(sf::BlendMultiply);
+    states.texture = &m_target.getTexture();
+    target.draw(quad, 4, sf::PrimitiveType::TriangleStrip, states);
+    RenderStats::addDrawCall(4);
+}
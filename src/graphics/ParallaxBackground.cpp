@@ -0,0 +1,55 @@
+#include "graphics/ParallaxBackground.hpp"
+#include "core/RenderStats.hpp"
+#include <cmath>
+#include <utility>
+
+void ParallaxBackground::addLayer(TextureHandle texture, sf::Vector2f scrollFactor)
+{
+    if (!texture)
+    {
+        return;
+    }
+    m_layers.push_back({std::move(texture), scrollFactor});
+}
+
+void ParallaxBackground::clear()
+{
+    m_layers.clear();
+}
+
+std::size_t ParallaxBackground::getLayerCount() const
+{
+    return m_layers.size();
+}
+
+void ParallaxBackground::draw(sf::RenderTarget &target, const sf::View &view) const
+{
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.f;
+    sf::Vector2f bottomRight = topLeft + view.getSize();
+
+    for (const Layer &layer : m_layers)
+    {
+        sf::Vector2f textureSize(layer.texture->getSize());
+
+        // texels per world unit, so the layer fills the view height
+        float scale = textureSize.y / view.getSize().y;
+
+        // wrapped to one texture repeat, texture coordinates stay small
+        // however far the camera goes
+        sf::Vector2f offset(std::fmod(topLeft.x * layer.scrollFactor.x * scale, textureSize.x),
+                            std::fmod(topLeft.y * layer.scrollFactor.y * scale, textureSize.y));
+        sf::Vector2f span = view.getSize() * scale;
+
+        const sf::Vertex quad[4] = {
+            {topLeft, sf::Color::White, offset},
+            {{bottomRight.x, topLeft.y}, sf::Color::White, {offset.x + span.x, offset.y}},
+            {{topLeft.x, bottomRight.y}, sf::Color::White, {offset.x, offset.y + span.y}},
+            {bottomRight, sf::Color::White, offset + span},
+        };
+
+        sf::RenderStates states;
+        states.texture = layer.texture.get();
+        target.draw(quad, 4, sf::PrimitiveType::TriangleStrip, states);
+        RenderStats::addDrawCall(4);
+    }
+}
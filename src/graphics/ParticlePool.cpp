@@ -0,0 +1,260 @@
+#include "graphics/ParticlePool.hpp"
+#include "core/RenderStats.hpp"
+#include <algorithm>
+#include <utility>
+
+static sf::Color mixColor(sf::Color from, sf::Color to, float t)
+{
+    auto mix = [t](std::uint8_t a, std::uint8_t b)
+    { return static_cast<std::uint8_t>(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t); };
+    return sf::Color(mix(from.r, to.r), mix(from.g, to.g), mix(from.b, to.b), mix(from.a, to.a));
+}
+
+ParticlePool::ParticlePool(std::size_t capacity)
+    : m_capacity(capacity),
+      m_count(0),
+      m_x(capacity),
+      m_y(capacity),
+      m_velocityX(capacity),
+      m_velocityY(capacity),
+      m_gravity(capacity),
+      m_age(capacity),
+      m_inverseLifetime(capacity),
+      m_emitter(capacity),
+      m_random(1234),
+      m_frameGrid(1, 1),
+      m_frameCount(1),
+      m_frameCorners(1),
+      m_vertices(capacity * 6),
+      m_vertexCount(0)
+{
+}
+
+void ParticlePool::setTexture(TextureHandle texture, sf::Vector2u frameGrid, unsigned int frameCount)
+{
+    m_texture = std::move(texture);
+    m_frameGrid = {std::max(frameGrid.x, 1u), std::max(frameGrid.y, 1u)};
+    unsigned int cells = m_frameGrid.x * m_frameGrid.y;
+    m_frameCount = frameCount == 0 ? cells : std::min(frameCount, cells);
+
+    m_frameSize = {0.f, 0.f};
+    if (m_texture)
+    {
+        sf::Vector2f textureSize(m_texture->getSize());
+        m_frameSize = {textureSize.x / static_cast<float>(m_frameGrid.x), textureSize.y / static_cast<float>(m_frameGrid.y)};
+    }
+    m_frameCorners.resize(m_frameCount);
+    for (unsigned int frame = 0; frame < m_frameCount; frame++)
+    {
+        m_frameCorners[frame] = {static_cast<float>(frame % m_frameGrid.x) * m_frameSize.x,
+                                 static_cast<float>(frame / m_frameGrid.x) * m_frameSize.y};
+    }
+}
+
+std::size_t ParticlePool::addEmitter(const ParticleSettings &settings, const sf::FloatRect &area, bool active)
+{
+    // sampled at the middle of each step, so the first and last steps are
+    // not stuck on the exact start and end values
+    Emitter emitter{settings, area, active, 0.f, {}};
+    for (std::size_t step = 0; step < LIFE_STEPS; step++)
+    {
+        float t = (static_cast<float>(step) + 0.5f) / static_cast<float>(LIFE_STEPS);
+        emitter.life[step].halfSize = (settings.startSize + (settings.endSize - settings.startSize) * t) / 2.f;
+        emitter.life[step].color = mixColor(settings.startColor, settings.endColor, t);
+    }
+
+    m_emitters.push_back(emitter);
+    return m_emitters.size() - 1;
+}
+
+void ParticlePool::setEmitterArea(std::size_t emitter, const sf::FloatRect &area)
+{
+    m_emitters[emitter].area = area;
+}
+
+void ParticlePool::setEmitterActive(std::size_t emitter, bool active)
+{
+    m_emitters[emitter].active = active;
+    if (!active)
+    {
+        m_emitters[emitter].pending = 0.f;
+    }
+}
+
+void ParticlePool::clearEmitters()
+{
+    m_emitters.clear();
+    m_count = 0;
+}
+
+float ParticlePool::jitter(float range)
+{
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    return unit(m_random) * range;
+}
+
+void ParticlePool::spawn(std::uint16_t emitter)
+{
+    if (m_count == m_capacity)
+    {
+        return;
+    }
+
+    const Emitter &source = m_emitters[emitter];
+    const ParticleSettings &settings = source.settings;
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    std::size_t i = m_count++;
+    m_x[i] = source.area.position.x + unit(m_random) * source.area.size.x;
+    m_y[i] = source.area.position.y + unit(m_random) * source.area.size.y;
+    m_velocityX[i] = settings.velocity.x + jitter(settings.velocityJitter.x);
+    m_velocityY[i] = settings.velocity.y + jitter(settings.velocityJitter.y);
+    m_gravity[i] = settings.gravity;
+    m_age[i] = 0.f;
+    m_inverseLifetime[i] = 1.f / std::max(settings.lifetime + jitter(settings.lifetimeJitter), 0.01f);
+    m_emitter[i] = emitter;
+}
+
+void ParticlePool::burst(std::size_t emitter, std::size_t count)
+{
+    for (std::size_t n = 0; n < count && m_count < m_capacity; n++)
+    {
+        spawn(static_cast<std::uint16_t>(emitter));
+    }
+}
+
+void ParticlePool::update(float deltaTime)
+{
+    // one short loop per array, plain arithmetic on at most two streams, so
+    // the compiler turns each into SIMD (a single loop over all of them
+    // needs more overlap checks than it is willing to emit)
+    float *x = m_x.data();
+    float *y = m_y.data();
+    float *velocityX = m_velocityX.data();
+    float *velocityY = m_velocityY.data();
+    const float *gravity = m_gravity.data();
+    float *age = m_age.data();
+    std::size_t count = m_count;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        velocityY[i] += gravity[i] * deltaTime;
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        x[i] += velocityX[i] * deltaTime;
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        y[i] += velocityY[i] * deltaTime;
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        age[i] += deltaTime;
+    }
+
+    // the last live particle takes over a dead one's slot
+    std::size_t i = 0;
+    while (i < m_count)
+    {
+        if (m_age[i] * m_inverseLifetime[i] < 1.f)
+        {
+            i++;
+            continue;
+        }
+
+        std::size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_velocityX[i] = m_velocityX[last];
+        m_velocityY[i] = m_velocityY[last];
+        m_gravity[i] = m_gravity[last];
+        m_age[i] = m_age[last];
+        m_inverseLifetime[i] = m_inverseLifetime[last];
+        m_emitter[i] = m_emitter[last];
+    }
+
+    // new particles start where they were emitted on the next draw
+    for (std::size_t e = 0; e < m_emitters.size(); e++)
+    {
+        Emitter &emitter = m_emitters[e];
+        if (!emitter.active)
+        {
+            continue;
+        }
+
+        emitter.pending += emitter.settings.rate * deltaTime;
+        for (; emitter.pending >= 1.f; emitter.pending -= 1.f)
+        {
+            spawn(static_cast<std::uint16_t>(e));
+        }
+    }
+}
+
+void ParticlePool::buildVertices(const sf::View &view)
+{
+    m_vertexCount = 0;
+
+    sf::Vector2f viewTopLeft = view.getCenter() - view.getSize() / 2.f;
+    sf::Vector2f viewBottomRight = viewTopLeft + view.getSize();
+    float frameScale = static_cast<float>(m_frameCount);
+    float stepScale = static_cast<float>(LIFE_STEPS);
+
+    // memory bound: six vertices of 20 bytes per particle, so everything
+    // per particle but the writes comes from small tables
+    sf::Vertex *quad = m_vertices.data();
+    for (std::size_t i = 0; i < m_count; i++)
+    {
+        float t = m_age[i] * m_inverseLifetime[i];
+        std::size_t step = std::min(static_cast<std::size_t>(t * stepScale), LIFE_STEPS - 1);
+        const LifeStep &life = m_emitters[m_emitter[i]].life[step];
+
+        float left = m_x[i] - life.halfSize;
+        float top = m_y[i] - life.halfSize;
+        float right = m_x[i] + life.halfSize;
+        float bottom = m_y[i] + life.halfSize;
+        if (right < viewTopLeft.x || left > viewBottomRight.x || bottom < viewTopLeft.y || top > viewBottomRight.y)
+        {
+            continue;
+        }
+
+        // flipbook frame for this point of the particle's life
+        unsigned int frame = std::min(static_cast<unsigned int>(t * frameScale), m_frameCount - 1);
+        sf::Vector2f uvTopLeft = m_frameCorners[frame];
+        sf::Vector2f uvBottomRight = uvTopLeft + m_frameSize;
+
+        quad[0] = {{left, top}, life.color, uvTopLeft};
+        quad[1] = {{right, top}, life.color, {uvBottomRight.x, uvTopLeft.y}};
+        quad[2] = {{left, bottom}, life.color, {uvTopLeft.x, uvBottomRight.y}};
+        quad[3] = quad[2];
+        quad[4] = quad[1];
+        quad[5] = {{right, bottom}, life.color, uvBottomRight};
+        quad += 6;
+    }
+    m_vertexCount = static_cast<std::size_t>(quad - m_vertices.data());
+}
+
+void ParticlePool::draw(sf::RenderTarget &target, const sf::View &view)
+{
+    buildVertices(view);
+    if (m_vertexCount == 0)
+    {
+        return;
+    }
+
+    // fire and sparks brighten what is behind them
+    sf::RenderStates states(sf::BlendAdd);
+    states.texture = m_texture.get();
+    target.draw(m_vertices.data(), m_vertexCount, sf::PrimitiveType::Triangles, states);
+    RenderStats::addDrawCall(m_vertexCount);
+}
+
+std::size_t ParticlePool::getCount() const
+{
+    return m_count;
+}
+
+std::size_t ParticlePool::getCapacity() const
+{
+    return m_capacity;
+}
@@ -0,0 +1,142 @@
+#include "graphics/ProfilerOverlay.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    const sf::Vector2f OVERLAY_POSITION(10.f, 10.f);
+    const float OVERLAY_WIDTH = 300.f;
+    const float GRAPH_HEIGHT = 60.f;
+    const float GRAPH_MAX_MS = 50.f; // top of the graph
+    const float TEXT_REFRESH_SECONDS = 0.25f;
+    const unsigned int TEXT_SIZE = 13;
+}
+
+ProfilerOverlay::ProfilerOverlay()
+    : m_hasText(false)
+{
+    m_background.setFillColor(sf::Color(0, 0, 0, 170));
+    m_background.setPosition(OVERLAY_POSITION);
+    m_frameTimes.reserve(Profiler::HISTORY_SIZE);
+}
+
+bool ProfilerOverlay::setFont(FontHandle font)
+{
+    if (!font)
+    {
+        std::cerr << "Error loading profiler overlay font!" << std::endl;
+        return false;
+    }
+
+    m_font = std::move(font);
+    m_text.emplace(*m_font, "", TEXT_SIZE);
+    m_text->setFillColor(sf::Color::White);
+    m_text->setPosition(OVERLAY_POSITION + sf::Vector2f(8.f, GRAPH_HEIGHT + 14.f));
+    return true;
+}
+
+void ProfilerOverlay::refreshText(std::size_t drawCalls, std::size_t vertices, const StreamingStats &streaming)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+
+    auto line = [&out](const char *name, const Profiler::Summary &summary)
+    {
+        out << std::left << std::setw(12) << name << std::right
+            << " p50 " << std::setw(6) << summary.p50
+            << "  p99 " << std::setw(6) << summary.p99 << " ms\n";
+    };
+
+    line("frame", Profiler::summarizeFrames());
+    for (std::size_t zone = 0; zone < static_cast<std::size_t>(ProfileZone::Count); zone++)
+    {
+        line(Profiler::getZoneName(static_cast<ProfileZone>(zone)), Profiler::summarize(static_cast<ProfileZone>(zone)));
+    }
+
+    out << "draw calls " << drawCalls << ", vertices " << vertices << "\n";
+    out << "streaming " << streaming.residentRegions << " regions, " << streaming.residentTiles << " tiles ("
+        << streaming.residentBytes / 1024 << " KB), " << streaming.pendingLoads << " pending, load "
+        << streaming.averageLoadMs << " ms avg, " << streaming.maxLoadMs << " max";
+    if (streaming.loadsFailed > 0)
+    {
+        out << ", " << streaming.loadsFailed << " failed";
+    }
+
+    m_text->setString(out.str());
+    m_hasText = true;
+}
+
+// bars from the bottom of the graph, oldest on the left
+void ProfilerOverlay::rebuildGraph(sf::Vector2f origin)
+{
+    Profiler::copyFrameTimes(m_frameTimes);
+
+    float barWidth = (OVERLAY_WIDTH - 16.f) / static_cast<float>(Profiler::HISTORY_SIZE);
+    float bottom = origin.y + GRAPH_HEIGHT;
+
+    m_graph.resize(m_frameTimes.size() * 6);
+    for (std::size_t i = 0; i < m_frameTimes.size(); i++)
+    {
+        float milliseconds = m_frameTimes[i];
+        float height = std::min(milliseconds / GRAPH_MAX_MS, 1.f) * GRAPH_HEIGHT;
+        float left = origin.x + static_cast<float>(i) * barWidth;
+        float right = left + barWidth;
+        float top = bottom - height;
+
+        sf::Color color = milliseconds <= 1000.f / 60.f   ? sf::Color(90, 200, 90)
+                          : milliseconds <= 1000.f / 30.f ? sf::Color(230, 200, 60)
+                                                          : sf::Color(230, 70, 60);
+
+        sf::Vertex *quad = &m_graph[i * 6];
+        quad[0].position = {left, top};
+        quad[1].position = {right, top};
+        quad[2].position = {left, bottom};
+        quad[3].position = {left, bottom};
+        quad[4].position = {right, top};
+        quad[5].position = {right, bottom};
+        for (int corner = 0; corner < 6; corner++)
+        {
+            quad[corner].color = color;
+        }
+    }
+
+    const float guideMs[] = {1000.f / 120.f, 1000.f / 60.f, 1000.f / 30.f};
+    m_guides.resize(6);
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        float y = bottom - guideMs[i] / GRAPH_MAX_MS * GRAPH_HEIGHT;
+        m_guides[i * 2].position = {origin.x, y};
+        m_guides[i * 2 + 1].position = {origin.x + OVERLAY_WIDTH - 16.f, y};
+        m_guides[i * 2].color = sf::Color(255, 255, 255, 80);
+        m_guides[i * 2 + 1].color = sf::Color(255, 255, 255, 80);
+    }
+}
+
+void ProfilerOverlay::draw(sf::RenderWindow &window, std::size_t drawCalls, std::size_t vertices, const StreamingStats &streaming)
+{
+    if (!m_text)
+    {
+        return;
+    }
+
+    if (!m_hasText || m_refreshClock.getElapsedTime().asSeconds() >= TEXT_REFRESH_SECONDS)
+    {
+        m_refreshClock.restart();
+        refreshText(drawCalls, vertices, streaming);
+    }
+
+    sf::Vector2f graphOrigin = OVERLAY_POSITION + sf::Vector2f(8.f, 8.f);
+    rebuildGraph(graphOrigin);
+
+    sf::FloatRect textBounds = m_text->getGlobalBounds();
+    m_background.setSize({std::max(OVERLAY_WIDTH, textBounds.position.x + textBounds.size.x + 8.f - OVERLAY_POSITION.x),
+                          textBounds.position.y + textBounds.size.y + 8.f - OVERLAY_POSITION.y});
+
+    window.setView(window.getDefaultView());
+    window.draw(m_background);
+    window.draw(m_graph);
+    window.draw(m_guides);
+    window.draw(*m_text);
+}
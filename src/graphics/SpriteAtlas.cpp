@@ -0,0 +1,175 @@
+#include "graphics/SpriteAtlas.hpp"
+#include "core/LittleEndian.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+
+namespace
+{
+    using LittleEndian::readU16;
+    using LittleEndian::readU32;
+
+    bool readString(std::istream &in, std::string &value)
+    {
+        std::uint16_t length = 0;
+        if (!readU16(in, length))
+        {
+            return false;
+        }
+        value.resize(length);
+        return length == 0 || static_cast<bool>(in.read(value.data(), length));
+    }
+}
+
+bool SpriteAtlas::loadFromFile(const std::string &indexPath, ResourceManager &resources)
+{
+    return loadIndex(indexPath, resources) && bindPages(resources);
+}
+
+bool SpriteAtlas::loadIndex(const std::string &indexPath, const ResourceManager &resources)
+{
+    std::optional<AssetPack::Blob> blob = resources.findInPack(indexPath);
+    if (blob)
+    {
+        BlobStreamBuffer buffer(*blob);
+        std::istream in(&buffer);
+        return readIndex(in, blob->size, indexPath);
+    }
+
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Error opening atlas index: " << indexPath << std::endl;
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    auto size = static_cast<std::uint64_t>(std::max<std::streamoff>(in.tellg(), 0));
+    in.seekg(0);
+    return readIndex(in, size, indexPath);
+}
+
+bool SpriteAtlas::readIndex(std::istream &in, std::uint64_t size, const std::string &indexPath)
+{
+    char magic[8];
+    std::uint32_t version = 0, pageCount = 0, sequenceCount = 0, frameCount = 0;
+    if (!in.read(magic, 8) || std::memcmp(magic, AtlasFormat::MAGIC, 8) != 0 ||
+        !readU32(in, version) || version != AtlasFormat::VERSION ||
+        !readU32(in, pageCount) || !readU32(in, sequenceCount) || !readU32(in, frameCount))
+    {
+        std::cerr << "Invalid atlas index: " << indexPath << std::endl;
+        return false;
+    }
+
+    // counts straight from the header: every page name takes at least its
+    // 2-byte length, every sequence 10 bytes and every frame 10, so a count
+    // the rest of the index cannot hold is corrupt; checked before anything
+    // is sized by it, in 64 bits so it cannot wrap
+    const std::uint64_t headerSize = 8 + 4 * 4;
+    std::uint64_t minimumSize = static_cast<std::uint64_t>(pageCount) * 2 +
+                                static_cast<std::uint64_t>(sequenceCount) * 10 +
+                                static_cast<std::uint64_t>(frameCount) * 10;
+    if (minimumSize > size - std::min(size, headerSize))
+    {
+        std::cerr << "Truncated atlas index: " << indexPath << std::endl;
+        return false;
+    }
+
+    std::filesystem::path directory = std::filesystem::path(indexPath).parent_path();
+
+    std::vector<std::string> pagePaths;
+    for (std::uint32_t i = 0; i < pageCount; i++)
+    {
+        std::string fileName;
+        if (!readString(in, fileName))
+        {
+            std::cerr << "Truncated atlas index: " << indexPath << std::endl;
+            return false;
+        }
+        pagePaths.push_back((directory / fileName).generic_string());
+    }
+
+    std::unordered_map<std::string, AtlasSequence> sequences;
+    for (std::uint32_t i = 0; i < sequenceCount; i++)
+    {
+        std::string name;
+        std::uint32_t first = 0, count = 0;
+        if (!readString(in, name) || !readU32(in, first) || !readU32(in, count) ||
+            first > frameCount || count > frameCount - first)
+        {
+            std::cerr << "Invalid atlas sequence in: " << indexPath << std::endl;
+            return false;
+        }
+        sequences[name] = {first, count};
+    }
+
+    std::vector<AtlasFrame> frames(frameCount);
+    for (AtlasFrame &frame : frames)
+    {
+        std::uint16_t page = 0, left = 0, top = 0, width = 0, height = 0;
+        if (!readU16(in, page) || !readU16(in, left) || !readU16(in, top) ||
+            !readU16(in, width) || !readU16(in, height) || page >= pageCount)
+        {
+            std::cerr << "Invalid atlas frame in: " << indexPath << std::endl;
+            return false;
+        }
+        frame.page = page;
+        frame.rect = sf::IntRect({left, top}, {width, height});
+    }
+
+    m_pagePaths = std::move(pagePaths);
+    m_pages.clear();
+    m_frames = std::move(frames);
+    m_sequences = std::move(sequences);
+    return true;
+}
+
+const std::vector<std::string> &SpriteAtlas::getPagePaths() const
+{
+    return m_pagePaths;
+}
+
+bool SpriteAtlas::bindPages(ResourceManager &resources)
+{
+    std::vector<TextureHandle> pages;
+    for (const std::string &path : m_pagePaths)
+    {
+        TextureHandle page = resources.getTexture(path);
+        if (!page)
+        {
+            return false;
+        }
+        pages.push_back(std::move(page));
+    }
+
+    m_pages = std::move(pages);
+    return true;
+}
+
+const AtlasSequence *SpriteAtlas::findSequence(const std::string &name) const
+{
+    auto it = m_sequences.find(name);
+    return it == m_sequences.end() ? nullptr : &it->second;
+}
+
+const AtlasFrame &SpriteAtlas::getFrame(std::uint32_t id) const
+{
+    return m_frames[id];
+}
+
+const TextureHandle &SpriteAtlas::getPage(std::uint16_t page) const
+{
+    return m_pages[page];
+}
+
+std::size_t SpriteAtlas::getFrameCount() const
+{
+    return m_frames.size();
+}
+
+bool SpriteAtlas::isLoaded() const
+{
+    return !m_pages.empty();
+}
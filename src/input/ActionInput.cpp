@@ -0,0 +1,111 @@
+#include "input/ActionInput.hpp"
+
+ActionInput::ActionInput()
+    : m_pressed(0),
+      m_released(0)
+{
+    m_keyDown.fill(false);
+    m_keysHeld.fill(0);
+
+    bind(sf::Keyboard::Key::A, Action::MoveLeft);
+    bind(sf::Keyboard::Key::Left, Action::MoveLeft);
+    bind(sf::Keyboard::Key::D, Action::MoveRight);
+    bind(sf::Keyboard::Key::Right, Action::MoveRight);
+    bind(sf::Keyboard::Key::Space, Action::Jump);
+    bind(sf::Keyboard::Key::W, Action::Jump);
+    bind(sf::Keyboard::Key::Up, Action::Jump);
+    bind(sf::Keyboard::Key::J, Action::Attack);
+    bind(sf::Keyboard::Key::LControl, Action::Attack);
+
+    bind(sf::Keyboard::Key::W, Action::MenuUp);
+    bind(sf::Keyboard::Key::Up, Action::MenuUp);
+    bind(sf::Keyboard::Key::S, Action::MenuDown);
+    bind(sf::Keyboard::Key::Down, Action::MenuDown);
+    bind(sf::Keyboard::Key::Enter, Action::MenuConfirm);
+    bind(sf::Keyboard::Key::Space, Action::MenuConfirm);
+}
+
+void ActionInput::bind(sf::Keyboard::Key key, Action action)
+{
+    m_bindings.push_back({key, action});
+}
+
+void ActionInput::clearBindings()
+{
+    releaseAll();
+    m_bindings.clear();
+}
+
+void ActionInput::setKey(sf::Keyboard::Key key, bool down)
+{
+    int code = static_cast<int>(key);
+    if (code < 0 || code >= static_cast<int>(sf::Keyboard::KeyCount) || m_keyDown[code] == down)
+    {
+        return; // unknown key, or the OS repeating a held one
+    }
+    m_keyDown[code] = down;
+
+    for (const Binding &binding : m_bindings)
+    {
+        if (binding.key != key)
+        {
+            continue;
+        }
+
+        std::uint8_t &keysHeld = m_keysHeld[static_cast<std::size_t>(binding.action)];
+        if (down && keysHeld++ == 0)
+        {
+            m_pressed |= actionBit(binding.action);
+        }
+        else if (!down && keysHeld > 0 && --keysHeld == 0)
+        {
+            m_released |= actionBit(binding.action);
+        }
+    }
+}
+
+void ActionInput::handleEvent(const sf::Event &event)
+{
+    if (const auto *keyPressed = event.getIf<sf::Event::KeyPressed>())
+    {
+        setKey(keyPressed->code, true);
+    }
+    else if (const auto *keyReleased = event.getIf<sf::Event::KeyReleased>())
+    {
+        setKey(keyReleased->code, false);
+    }
+    else if (event.is<sf::Event::FocusLost>())
+    {
+        // the release would go to another window
+        releaseAll();
+    }
+}
+
+void ActionInput::releaseAll()
+{
+    for (int code = 0; code < static_cast<int>(sf::Keyboard::KeyCount); code++)
+    {
+        if (m_keyDown[code])
+        {
+            setKey(static_cast<sf::Keyboard::Key>(code), false);
+        }
+    }
+}
+
+PlayerInput ActionInput::takeStep()
+{
+    PlayerInput input;
+    for (std::size_t i = 0; i < m_keysHeld.size(); i++)
+    {
+        if (m_keysHeld[i] > 0)
+        {
+            input.held |= actionBit(static_cast<Action>(i));
+        }
+    }
+    input.pressed = m_pressed;
+    input.released = m_released;
+
+    m_pressed = 0;
+    m_released = 0;
+    return input;
+}
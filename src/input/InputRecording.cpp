@@ -0,0 +1,197 @@
+#include "input/InputRecording.hpp"
+#include "core/LittleEndian.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace
+{
+    using LittleEndian::readU32;
+    using LittleEndian::readU64;
+    using LittleEndian::writeU32;
+    using LittleEndian::writeU64;
+
+    bool sameInput(const PlayerInput &a, const PlayerInput &b)
+    {
+        return a.held == b.held && a.pressed == b.pressed && a.released == b.released;
+    }
+}
+
+InputRecording::InputRecording()
+    : m_timestep(0.f)
+{
+}
+
+void InputRecording::reset(float timestep, const std::string &levelPath)
+{
+    m_timestep = timestep;
+    m_levelPath = levelPath;
+    m_inputs.clear();
+    m_hashes.clear();
+}
+
+void InputRecording::record(const PlayerInput &input, std::uint64_t stateHash)
+{
+    m_inputs.push_back(input);
+    m_hashes.push_back(stateHash);
+}
+
+bool InputRecording::loadFromFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Error opening input recording: " << path << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::size_t offset = 0;
+    auto has = [&](std::size_t size)
+    { return data.size() - offset >= size; };
+
+    if (!has(8 + 4 * 4) || std::memcmp(data.data(), InputFormat::MAGIC, sizeof(InputFormat::MAGIC)) != 0)
+    {
+        std::cerr << "Error: " << path << " is not an input recording" << std::endl;
+        return false;
+    }
+    offset += 8;
+
+    std::uint32_t version = readU32(&data[offset]);
+    if (version != InputFormat::VERSION)
+    {
+        std::cerr << "Error: input recording " << path << " has version " << version
+                  << ", expected " << InputFormat::VERSION << std::endl;
+        return false;
+    }
+
+    std::uint32_t timestepBits = readU32(&data[offset + 4]);
+    float timestep;
+    std::memcpy(&timestep, &timestepBits, sizeof(timestep));
+    std::uint32_t tickCount = readU32(&data[offset + 8]);
+    std::uint32_t pathLength = readU32(&data[offset + 12]);
+    offset += 16;
+
+    if (!has(static_cast<std::size_t>(pathLength) + 4))
+    {
+        std::cerr << "Error: input recording " << path << " is truncated" << std::endl;
+        return false;
+    }
+    std::string levelPath(reinterpret_cast<const char *>(&data[offset]), pathLength);
+    std::uint32_t runCount = readU32(&data[offset + pathLength]);
+    offset += pathLength + 4;
+
+    if (!has(static_cast<std::size_t>(runCount) * InputFormat::RUN_SIZE + static_cast<std::size_t>(tickCount) * 8))
+    {
+        std::cerr << "Error: input recording " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    reset(timestep, levelPath);
+    m_inputs.reserve(tickCount);
+    m_hashes.reserve(tickCount);
+
+    for (std::uint32_t run = 0; run < runCount; run++)
+    {
+        PlayerInput input;
+        input.held = data[offset];
+        input.pressed = data[offset + 1];
+        input.released = data[offset + 2];
+        std::uint32_t length = readU32(&data[offset + 3]);
+        offset += InputFormat::RUN_SIZE;
+
+        if (m_inputs.size() + length > tickCount)
+        {
+            std::cerr << "Error: input recording " << path << " has more input than ticks" << std::endl;
+            return false;
+        }
+        m_inputs.insert(m_inputs.end(), length, input);
+    }
+
+    if (m_inputs.size() != tickCount)
+    {
+        std::cerr << "Error: input recording " << path << " has less input than ticks" << std::endl;
+        return false;
+    }
+
+    for (std::uint32_t tick = 0; tick < tickCount; tick++)
+    {
+        m_hashes.push_back(readU64(&data[offset]));
+        offset += 8;
+    }
+
+    return true;
+}
+
+bool InputRecording::saveToFile(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Error writing input recording: " << path << std::endl;
+        return false;
+    }
+
+    // runs of unchanged input
+    std::vector<std::pair<PlayerInput, std::uint32_t>> runs;
+    for (const PlayerInput &input : m_inputs)
+    {
+        if (runs.empty() || !sameInput(runs.back().first, input))
+        {
+            runs.emplace_back(input, 0);
+        }
+        runs.back().second++;
+    }
+
+    std::uint32_t timestepBits;
+    std::memcpy(&timestepBits, &m_timestep, sizeof(timestepBits));
+
+    out.write(InputFormat::MAGIC, sizeof(InputFormat::MAGIC));
+    writeU32(out, InputFormat::VERSION);
+    writeU32(out, timestepBits);
+    writeU32(out, static_cast<std::uint32_t>(m_inputs.size()));
+    writeU32(out, static_cast<std::uint32_t>(m_levelPath.size()));
+    out.write(m_levelPath.data(), static_cast<std::streamsize>(m_levelPath.size()));
+    writeU32(out, static_cast<std::uint32_t>(runs.size()));
+
+    for (const auto &[input, length] : runs)
+    {
+        out.put(static_cast<char>(input.held));
+        out.put(static_cast<char>(input.pressed));
+        out.put(static_cast<char>(input.released));
+        writeU32(out, length);
+    }
+
+    for (std::uint64_t hash : m_hashes)
+    {
+        writeU64(out, hash);
+    }
+
+    return static_cast<bool>(out);
+}
+
+float InputRecording::getTimestep() const
+{
+    return m_timestep;
+}
+
+const std::string &InputRecording::getLevelPath() const
+{
+    return m_levelPath;
+}
+
+std::size_t InputRecording::getTickCount() const
+{
+    return m_inputs.size();
+}
+
+PlayerInput InputRecording::getInput(std::size_t tick) const
+{
+    return m_inputs[tick];
+}
+
+std::uint64_t InputRecording::getStateHash(std::size_t tick) const
+{
+    return m_hashes[tick];
+}
@@ -0,0 +1,67 @@
+#include "input/PlayerInput.hpp"
+
+bool PlayerInput::isHeld(Action action) const
+{
+    return (held & actionBit(action)) != 0;
+}
+
+bool PlayerInput::wasPressed(Action action) const
+{
+    return (pressed & actionBit(action)) != 0;
+}
+
+bool PlayerInput::wasReleased(Action action) const
+{
+    return (released & actionBit(action)) != 0;
+}
+
+bool PlayerInput::isActive(Action action) const
+{
+    return ((held | pressed) & actionBit(action)) != 0;
+}
+
+PlayerInput PlayerInput::fromHeld(ActionBits held, ActionBits previousHeld)
+{
+    PlayerInput input;
+    input.held = held;
+    input.pressed = static_cast<ActionBits>(held & ~previousHeld);
+    input.released = static_cast<ActionBits>(previousHeld & ~held);
+    return input;
+}
+
+InputBuffer::InputBuffer()
+{
+    clear();
+}
+
+void InputBuffer::update(const PlayerInput &input)
+{
+    for (std::size_t i = 0; i < m_age.size(); i++)
+    {
+        if (input.wasPressed(static_cast<Action>(i)))
+        {
+            m_age[i] = 0;
+        }
+        else if (m_age[i] < NO_PRESS - 1)
+        {
+            m_age[i]++;
+        }
+    }
+}
+
+bool InputBuffer::consume(Action action, std::uint16_t window)
+{
+    std::uint16_t &age = m_age[static_cast<std::size_t>(action)];
+    if (age == NO_PRESS || age >= window)
+    {
+        return false;
+    }
+
+    age = NO_PRESS;
+    return true;
+}
+
+void InputBuffer::clear()
+{
+    m_age.fill(NO_PRESS);
+}
@@ -0,0 +1,465 @@
+#include "level/Level.hpp"
+#include "core/LittleEndian.hpp"
+#include "core/ResourceManager.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    using LittleEndian::readF32;
+    using LittleEndian::readU32;
+    using LittleEndian::readU64;
+    using LittleEndian::writeF32;
+    using LittleEndian::writeU32;
+    using LittleEndian::writeU64;
+
+    // tile rectangle covered by a region
+    void regionBounds(const LevelInfo &info, std::uint32_t region, std::uint32_t &x, std::uint32_t &y,
+                      std::uint32_t &width, std::uint32_t &height)
+    {
+        x = (region % info.getRegionColumns()) * info.regionSize;
+        y = (region / info.getRegionColumns()) * info.regionSize;
+        width = std::min(info.regionSize, info.width - x);
+        height = std::min(info.regionSize, info.height - y);
+    }
+}
+
+std::uint32_t LevelInfo::getRegionColumns() const
+{
+    return (width + regionSize - 1) / regionSize;
+}
+
+std::uint32_t LevelInfo::getRegionRows() const
+{
+    return (height + regionSize - 1) / regionSize;
+}
+
+LevelFile::LevelFile()
+    : m_info{0, 0, 32, 32, 1, 0, LevelFormat::DEFAULT_REGION_SIZE, false}
+{
+}
+
+bool LevelFile::readAt(std::uint64_t offset, void *out, std::size_t size) const
+{
+    if (m_blob)
+    {
+        if (offset + size > m_blob->size)
+        {
+            return false;
+        }
+        std::memcpy(out, static_cast<const unsigned char *>(m_blob->data) + offset, size);
+        return true;
+    }
+
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(offset));
+    return static_cast<bool>(m_file.read(static_cast<char *>(out), static_cast<std::streamsize>(size)));
+}
+
+bool LevelFile::open(const std::string &path, const ResourceManager &resources)
+{
+    m_path = path;
+    m_blob = resources.findInPack(path);
+    m_spawns.clear();
+    m_regions.clear();
+
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    if (!m_blob)
+    {
+        m_file.open(path, std::ios::binary);
+        if (!m_file)
+        {
+            std::cerr << "Error opening level: " << path << std::endl;
+            return false;
+        }
+    }
+
+    std::uint64_t fileSize = 0;
+    if (m_blob)
+    {
+        fileSize = m_blob->size;
+    }
+    else
+    {
+        m_file.seekg(0, std::ios::end);
+        fileSize = static_cast<std::uint64_t>(std::max<std::streamoff>(m_file.tellg(), 0));
+    }
+
+    unsigned char header[LevelFormat::HEADER_SIZE];
+    if (!readAt(0, header, sizeof(header)) || std::memcmp(header, LevelFormat::MAGIC, sizeof(LevelFormat::MAGIC)) != 0)
+    {
+        std::cerr << "Error: not a level file: " << path << std::endl;
+        return false;
+    }
+
+    const unsigned char *fields = header + sizeof(LevelFormat::MAGIC);
+    std::uint32_t version = readU32(fields);
+    if (version != LevelFormat::VERSION)
+    {
+        std::cerr << "Error: level " << path << " has version " << version
+                  << ", expected " << LevelFormat::VERSION << std::endl;
+        return false;
+    }
+
+    m_info.tileWidth = readU32(fields + 4);
+    m_info.tileHeight = readU32(fields + 8);
+    m_info.width = readU32(fields + 12);
+    m_info.height = readU32(fields + 16);
+    m_info.tilesetColumns = readU32(fields + 20);
+    m_info.layerCount = readU32(fields + 24);
+    std::uint32_t spawnCount = readU32(fields + 28);
+    m_info.hasCollision = (readU32(fields + 32) & LevelFormat::HAS_COLLISION) != 0;
+    m_info.regionSize = readU32(fields + 36);
+
+    if (m_info.width == 0 || m_info.height == 0 || m_info.layerCount == 0 || m_info.tileWidth == 0 ||
+        m_info.tileHeight == 0 || m_info.tilesetColumns == 0 || m_info.regionSize == 0 || m_info.regionSize % 16 != 0)
+    {
+        std::cerr << "Error: level " << path << " is corrupt" << std::endl;
+        return false;
+    }
+
+    // counts straight from the header: check the tables they describe fit
+    // in the file before sizing anything by them, in 64 bits so a hostile
+    // count cannot wrap the product back into range
+    std::uint64_t regionColumns = (static_cast<std::uint64_t>(m_info.width) + m_info.regionSize - 1) / m_info.regionSize;
+    std::uint64_t regionRows = (static_cast<std::uint64_t>(m_info.height) + m_info.regionSize - 1) / m_info.regionSize;
+    std::uint64_t tableBytes = static_cast<std::uint64_t>(spawnCount) * LevelFormat::SPAWN_SIZE +
+                               regionColumns * regionRows * LevelFormat::REGION_ENTRY_SIZE;
+    if (tableBytes > fileSize - std::min<std::uint64_t>(fileSize, LevelFormat::HEADER_SIZE))
+    {
+        std::cerr << "Error: level " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    auto regionCount = static_cast<std::uint32_t>(regionColumns * regionRows);
+    std::vector<unsigned char> tables(static_cast<std::size_t>(tableBytes));
+    if (!readAt(LevelFormat::HEADER_SIZE, tables.data(), tables.size()))
+    {
+        std::cerr << "Error: level " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    const unsigned char *cursor = tables.data();
+    m_spawns.reserve(spawnCount);
+    for (std::uint32_t i = 0; i < spawnCount; i++, cursor += LevelFormat::SPAWN_SIZE)
+    {
+        std::uint32_t kind = readU32(cursor);
+        if (kind >= static_cast<std::uint32_t>(SpawnKind::Count))
+        {
+            std::cerr << "Error: level " << path << " has unknown spawn kind " << kind << std::endl;
+            return false;
+        }
+        m_spawns.push_back({static_cast<SpawnKind>(kind), {readF32(cursor + 4), readF32(cursor + 8)}});
+    }
+
+    m_regions.reserve(regionCount);
+    for (std::uint32_t i = 0; i < regionCount; i++, cursor += LevelFormat::REGION_ENTRY_SIZE)
+    {
+        RegionEntry entry{readU64(cursor), readU32(cursor + 8), readU32(cursor + 12)};
+
+        std::uint32_t x, y, width, height;
+        regionBounds(m_info, i, x, y, width, height);
+        std::size_t cells = static_cast<std::size_t>(width) * height;
+        if (entry.size != cells * (m_info.layerCount * sizeof(std::uint16_t) + (m_info.hasCollision ? 1 : 0)) ||
+            entry.offset > fileSize || entry.size > fileSize - entry.offset)
+        {
+            std::cerr << "Error: level " << path << " has a corrupt region " << i << std::endl;
+            return false;
+        }
+        m_regions.push_back(entry);
+    }
+
+    return true;
+}
+
+const LevelInfo &LevelFile::getInfo() const
+{
+    return m_info;
+}
+
+const std::vector<LevelSpawn> &LevelFile::getSpawns() const
+{
+    return m_spawns;
+}
+
+std::uint32_t LevelFile::getRegionCount() const
+{
+    return static_cast<std::uint32_t>(m_regions.size());
+}
+
+std::uint32_t LevelFile::getRegionTileCount(std::uint32_t region) const
+{
+    return m_regions[region].tileCount;
+}
+
+bool LevelFile::readRegion(std::uint32_t region, LevelRegion &out) const
+{
+    const RegionEntry &entry = m_regions[region];
+    out.index = region;
+    regionBounds(m_info, region, out.x, out.y, out.width, out.height);
+
+    // cells are stored little-endian, which is every platform we ship on,
+    // so each grid comes across in one copy
+    std::size_t cells = static_cast<std::size_t>(out.width) * out.height;
+    out.tiles.resize(cells * m_info.layerCount);
+    out.collision.resize(m_info.hasCollision ? cells : 0);
+
+    std::size_t tileBytes = out.tiles.size() * sizeof(std::uint16_t);
+    if ((tileBytes > 0 && !readAt(entry.offset, out.tiles.data(), tileBytes)) ||
+        (!out.collision.empty() && !readAt(entry.offset + tileBytes, out.collision.data(), out.collision.size())))
+    {
+        std::cerr << "Error reading region " << region << " of level " << m_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Level::Level()
+    : m_info{0, 0, 32, 32, 1, 0, LevelFormat::DEFAULT_REGION_SIZE, false}
+{
+}
+
+void Level::create(std::uint32_t width, std::uint32_t height, std::uint32_t tileWidth, std::uint32_t tileHeight,
+                   std::uint32_t tilesetColumns, std::uint32_t layerCount, bool hasCollision)
+{
+    m_info = {width, height, tileWidth, tileHeight, tilesetColumns, layerCount, m_info.regionSize, hasCollision};
+    m_tiles.assign(static_cast<std::size_t>(width) * height * layerCount, 0);
+    m_collision.assign(hasCollision ? static_cast<std::size_t>(width) * height : 0, 0);
+    m_spawns.clear();
+}
+
+void Level::setRegionSize(std::uint32_t regionSize)
+{
+    m_info.regionSize = regionSize;
+}
+
+bool Level::loadFromFile(const std::string &path, const ResourceManager &resources)
+{
+    LevelFile file;
+    if (!file.open(path, resources))
+    {
+        return false;
+    }
+
+    const LevelInfo &info = file.getInfo();
+    create(info.width, info.height, info.tileWidth, info.tileHeight, info.tilesetColumns, info.layerCount, info.hasCollision);
+    m_info.regionSize = info.regionSize;
+    m_spawns = file.getSpawns();
+
+    // stitch the regions back into whole-map grids, a row at a time
+    LevelRegion region;
+    std::size_t layerSize = static_cast<std::size_t>(info.width) * info.height;
+    for (std::uint32_t i = 0; i < file.getRegionCount(); i++)
+    {
+        if (!file.readRegion(i, region))
+        {
+            return false;
+        }
+
+        std::size_t regionCells = static_cast<std::size_t>(region.width) * region.height;
+        for (std::uint32_t row = 0; row < region.height; row++)
+        {
+            std::size_t mapCell = static_cast<std::size_t>(region.y + row) * info.width + region.x;
+            std::size_t regionCell = static_cast<std::size_t>(row) * region.width;
+
+            for (std::uint32_t layer = 0; layer < info.layerCount; layer++)
+            {
+                std::memcpy(&m_tiles[layer * layerSize + mapCell], &region.tiles[layer * regionCells + regionCell],
+                            region.width * sizeof(std::uint16_t));
+            }
+            if (info.hasCollision)
+            {
+                std::memcpy(&m_collision[mapCell], &region.collision[regionCell], region.width);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Level::saveToFile(const std::string &path) const
+{
+    if (m_info.regionSize == 0 || m_info.regionSize % 16 != 0)
+    {
+        std::cerr << "Error: region size " << m_info.regionSize << " is not a multiple of 16" << std::endl;
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Error writing level: " << path << std::endl;
+        return false;
+    }
+
+    std::uint32_t regionCount = m_info.getRegionColumns() * m_info.getRegionRows();
+
+    out.write(LevelFormat::MAGIC, sizeof(LevelFormat::MAGIC));
+    writeU32(out, LevelFormat::VERSION);
+    writeU32(out, m_info.tileWidth);
+    writeU32(out, m_info.tileHeight);
+    writeU32(out, m_info.width);
+    writeU32(out, m_info.height);
+    writeU32(out, m_info.tilesetColumns);
+    writeU32(out, m_info.layerCount);
+    writeU32(out, static_cast<std::uint32_t>(m_spawns.size()));
+    writeU32(out, hasCollisionLayer() ? LevelFormat::HAS_COLLISION : 0);
+    writeU32(out, m_info.regionSize);
+
+    for (const LevelSpawn &spawn : m_spawns)
+    {
+        writeU32(out, static_cast<std::uint32_t>(spawn.kind));
+        writeF32(out, spawn.position.x);
+        writeF32(out, spawn.position.y);
+    }
+
+    // region table, then the regions in the same order
+    std::uint64_t offset = LevelFormat::HEADER_SIZE + m_spawns.size() * LevelFormat::SPAWN_SIZE +
+                           static_cast<std::uint64_t>(regionCount) * LevelFormat::REGION_ENTRY_SIZE;
+    for (std::uint32_t region = 0; region < regionCount; region++)
+    {
+        std::uint32_t x0, y0, width, height;
+        regionBounds(m_info, region, x0, y0, width, height);
+
+        // what Ground will hold: a tile per drawn layer cell, or one
+        // collision-only tile for a solid cell with nothing drawn
+        std::uint32_t tileCount = 0;
+        for (std::uint32_t y = y0; y < y0 + height; y++)
+        {
+            for (std::uint32_t x = x0; x < x0 + width; x++)
+            {
+                std::uint32_t drawn = 0;
+                for (std::uint32_t layer = 0; layer < m_info.layerCount; layer++)
+                {
+                    drawn += getTile(layer, x, y) != 0 ? 1 : 0;
+                }
+                tileCount += drawn > 0 ? drawn : (isSolid(x, y) ? 1 : 0);
+            }
+        }
+
+        std::uint32_t size = width * height * (m_info.layerCount * 2 + (hasCollisionLayer() ? 1 : 0));
+        writeU64(out, offset);
+        writeU32(out, size);
+        writeU32(out, tileCount);
+        offset += size;
+    }
+
+    for (std::uint32_t region = 0; region < regionCount; region++)
+    {
+        std::uint32_t x0, y0, width, height;
+        regionBounds(m_info, region, x0, y0, width, height);
+
+        for (std::uint32_t layer = 0; layer < m_info.layerCount; layer++)
+        {
+            for (std::uint32_t y = y0; y < y0 + height; y++)
+            {
+                out.write(reinterpret_cast<const char *>(getLayer(layer) + static_cast<std::size_t>(y) * m_info.width + x0),
+                          static_cast<std::streamsize>(width * sizeof(std::uint16_t)));
+            }
+        }
+        for (std::uint32_t y = y0; y < y0 + height && hasCollisionLayer(); y++)
+        {
+            out.write(reinterpret_cast<const char *>(m_collision.data() + static_cast<std::size_t>(y) * m_info.width + x0),
+                      static_cast<std::streamsize>(width));
+        }
+    }
+
+    return static_cast<bool>(out);
+}
+
+const LevelInfo &Level::getInfo() const
+{
+    return m_info;
+}
+
+std::uint32_t Level::getWidth() const
+{
+    return m_info.width;
+}
+
+std::uint32_t Level::getHeight() const
+{
+    return m_info.height;
+}
+
+std::uint32_t Level::getTileWidth() const
+{
+    return m_info.tileWidth;
+}
+
+std::uint32_t Level::getTileHeight() const
+{
+    return m_info.tileHeight;
+}
+
+std::uint32_t Level::getTilesetColumns() const
+{
+    return m_info.tilesetColumns;
+}
+
+std::uint32_t Level::getLayerCount() const
+{
+    return m_info.layerCount;
+}
+
+std::uint16_t Level::getTile(std::uint32_t layer, std::uint32_t x, std::uint32_t y) const
+{
+    return getLayer(layer)[static_cast<std::size_t>(y) * m_info.width + x];
+}
+
+void Level::setTile(std::uint32_t layer, std::uint32_t x, std::uint32_t y, std::uint16_t cell)
+{
+    m_tiles[(static_cast<std::size_t>(layer) * m_info.height + y) * m_info.width + x] = cell;
+}
+
+const std::uint16_t *Level::getLayer(std::uint32_t layer) const
+{
+    return m_tiles.data() + static_cast<std::size_t>(layer) * m_info.width * m_info.height;
+}
+
+bool Level::hasCollisionLayer() const
+{
+    return !m_collision.empty();
+}
+
+const std::uint8_t *Level::getCollisionLayer() const
+{
+    return hasCollisionLayer() ? m_collision.data() : nullptr;
+}
+
+bool Level::isSolid(std::uint32_t x, std::uint32_t y) const
+{
+    std::size_t cell = static_cast<std::size_t>(y) * m_info.width + x;
+    if (hasCollisionLayer())
+    {
+        return m_collision[cell] != 0;
+    }
+
+    for (std::uint32_t layer = 0; layer < m_info.layerCount; layer++)
+    {
+        if (getLayer(layer)[cell] != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Level::setSolid(std::uint32_t x, std::uint32_t y, bool solid)
+{
+    m_collision[static_cast<std::size_t>(y) * m_info.width + x] = solid ? 1 : 0;
+}
+
+const std::vector<LevelSpawn> &Level::getSpawns() const
+{
+    return m_spawns;
+}
+
+void Level::addSpawn(SpawnKind kind, sf::Vector2f position)
+{
+    m_spawns.push_back({kind, position});
+}
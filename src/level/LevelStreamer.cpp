@@ -0,0 +1,288 @@
+#include "level/LevelStreamer.hpp"
+#include "core/Tracer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+LevelStreamer::LevelStreamer(const StreamingSettings &settings)
+    : m_settings(settings),
+      m_workerBusy(false),
+      m_stopping(false),
+      m_budgetTiles(0),
+      m_totalLoadMs(0.0),
+      m_stats{}
+{
+    m_worker = std::thread(&LevelStreamer::workerLoop, this);
+}
+
+LevelStreamer::~LevelStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_requests.clear();
+    }
+    m_wakeWorker.notify_all();
+    m_worker.join();
+}
+
+// call before the first update, the worker reads this file afterwards
+bool LevelStreamer::open(const std::string &path, const ResourceManager &resources)
+{
+    // nothing of the previous file may arrive after this: drop what is still
+    // queued and wait out the read in flight, which also keeps the worker
+    // off m_file while it is reopened
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_requests.clear();
+        m_workerIdle.wait(lock, [this]()
+                          { return !m_workerBusy; });
+        m_prepared.clear();
+    }
+    m_arrived.clear();
+    m_states.clear();
+    m_resident.clear();
+    m_budgetTiles = 0;
+    m_totalLoadMs = 0.0;
+    m_stats = StreamingStats{};
+
+    if (!m_file.open(path, resources))
+    {
+        return false;
+    }
+
+    m_states.assign(m_file.getRegionCount(), RegionState::Unloaded);
+    m_requestedAt.assign(m_file.getRegionCount(), std::chrono::steady_clock::time_point());
+    m_retryAt.assign(m_file.getRegionCount(), std::chrono::steady_clock::time_point());
+    m_resident.reserve(m_file.getRegionCount());
+    m_candidates.reserve(m_file.getRegionCount());
+    return true;
+}
+
+const LevelFile &LevelStreamer::getFile() const
+{
+    return m_file;
+}
+
+void LevelStreamer::workerLoop()
+{
+    Tracer::setThreadName("level streamer");
+    LevelRegion region;
+
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWorker.wait(lock, [this]()
+                              { return m_stopping || !m_requests.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            request = m_requests.front();
+            m_requests.pop_front();
+            m_workerBusy = true;
+        }
+
+        // file read and chunk building happen here, off the simulation thread;
+        // a region that fails to read still comes back, marked not ok, so
+        // update can put it back in line rather than wait on it forever
+        {
+            TRACE_ZONE("load region");
+            Ground::PreparedRegion prepared{request.region, false, 0, {}};
+            if (m_file.readRegion(request.region, region))
+            {
+                prepared = request.ground->prepareRegion(region);
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_prepared.push_back(std::move(prepared));
+            m_workerBusy = false;
+        }
+        m_workerIdle.notify_all();
+    }
+}
+
+// from center to the nearest point of the region
+float LevelStreamer::distanceTo(std::uint32_t region, sf::Vector2f center) const
+{
+    const LevelInfo &info = m_file.getInfo();
+    float regionWidth = static_cast<float>(info.regionSize * info.tileWidth);
+    float regionHeight = static_cast<float>(info.regionSize * info.tileHeight);
+    float left = static_cast<float>(region % info.getRegionColumns()) * regionWidth;
+    float top = static_cast<float>(region / info.getRegionColumns()) * regionHeight;
+
+    float dx = std::max({left - center.x, 0.f, center.x - (left + regionWidth)});
+    float dy = std::max({top - center.y, 0.f, center.y - (top + regionHeight)});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void LevelStreamer::evict(std::uint32_t region, Ground &ground)
+{
+    ground.removeRegion(region);
+    m_states[region] = RegionState::Unloaded;
+    m_budgetTiles -= m_file.getRegionTileCount(region);
+    m_stats.evictions++;
+
+    auto it = std::find(m_resident.begin(), m_resident.end(), region);
+    *it = m_resident.back();
+    m_resident.pop_back();
+}
+
+void LevelStreamer::update(sf::Vector2f center, Ground &ground)
+{
+    if (m_states.empty())
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    // swap in whatever the worker finished
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (!m_prepared.empty())
+        {
+            m_arrived.push_back(std::move(m_prepared.front()));
+            m_prepared.pop_front();
+        }
+    }
+
+    for (Ground::PreparedRegion &region : m_arrived)
+    {
+        std::uint32_t index = region.index;
+        m_stats.pendingLoads--;
+
+        // never resident, or the bodies on it would fall through
+        if (!region.ok)
+        {
+            std::cerr << "Error loading level region " << index << ", trying again in "
+                      << RETRY_DELAY.count() << " ms" << std::endl;
+            m_states[index] = RegionState::Unloaded;
+            m_budgetTiles -= m_file.getRegionTileCount(index);
+            m_retryAt[index] = now + RETRY_DELAY;
+            m_stats.loadsFailed++;
+            continue;
+        }
+
+        // walked away while it was loading
+        if (distanceTo(index, center) > m_settings.unloadRadius)
+        {
+            m_states[index] = RegionState::Unloaded;
+            m_budgetTiles -= m_file.getRegionTileCount(index);
+            continue;
+        }
+
+        ground.addRegion(std::move(region));
+        m_states[index] = RegionState::Resident;
+        m_resident.push_back(index);
+
+        float loadMs = std::chrono::duration<float, std::milli>(now - m_requestedAt[index]).count();
+        m_stats.loadsCompleted++;
+        m_stats.lastLoadMs = loadMs;
+        m_stats.maxLoadMs = std::max(m_stats.maxLoadMs, loadMs);
+        m_totalLoadMs += loadMs;
+        m_stats.averageLoadMs = static_cast<float>(m_totalLoadMs / static_cast<double>(m_stats.loadsCompleted));
+    }
+    m_arrived.clear();
+
+    // past the unload radius, not the load radius: the band in between
+    // keeps a region on the edge from going and coming back every step
+    for (std::size_t i = 0; i < m_resident.size();)
+    {
+        if (distanceTo(m_resident[i], center) > m_settings.unloadRadius)
+        {
+            evict(m_resident[i], ground); // swaps another region into i
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    // every missing region in range, nearest first
+    const LevelInfo &info = m_file.getInfo();
+    float regionWidth = static_cast<float>(info.regionSize * info.tileWidth);
+    float regionHeight = static_cast<float>(info.regionSize * info.tileHeight);
+    int lastColumn = static_cast<int>(info.getRegionColumns()) - 1;
+    int lastRow = static_cast<int>(info.getRegionRows()) - 1;
+
+    int firstX = std::clamp(static_cast<int>(std::floor((center.x - m_settings.loadRadius) / regionWidth)), 0, lastColumn);
+    int lastX = std::clamp(static_cast<int>(std::floor((center.x + m_settings.loadRadius) / regionWidth)), 0, lastColumn);
+    int firstY = std::clamp(static_cast<int>(std::floor((center.y - m_settings.loadRadius) / regionHeight)), 0, lastRow);
+    int lastY = std::clamp(static_cast<int>(std::floor((center.y + m_settings.loadRadius) / regionHeight)), 0, lastRow);
+
+    m_candidates.clear();
+    for (int y = firstY; y <= lastY; y++)
+    {
+        for (int x = firstX; x <= lastX; x++)
+        {
+            std::uint32_t region = static_cast<std::uint32_t>(y * (lastColumn + 1) + x);
+            float distance = distanceTo(region, center);
+            if (m_states[region] == RegionState::Unloaded && distance <= m_settings.loadRadius && now >= m_retryAt[region])
+            {
+                m_candidates.push_back({distance, region});
+            }
+        }
+    }
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate &a, const Candidate &b)
+              { return a.distance != b.distance ? a.distance < b.distance : a.region < b.region; });
+
+    std::size_t requested = 0;
+    for (const Candidate &candidate : m_candidates)
+    {
+        std::size_t tiles = m_file.getRegionTileCount(candidate.region);
+
+        // make room by dropping regions only the hysteresis band still
+        // holds, farthest first; never ones inside the load radius
+        while (m_budgetTiles + tiles > m_settings.maxResidentTiles)
+        {
+            std::uint32_t farthest = 0;
+            float farthestDistance = m_settings.loadRadius;
+            for (std::uint32_t region : m_resident)
+            {
+                float distance = distanceTo(region, center);
+                if (distance > farthestDistance)
+                {
+                    farthest = region;
+                    farthestDistance = distance;
+                }
+            }
+            if (farthestDistance <= m_settings.loadRadius)
+            {
+                break;
+            }
+            evict(farthest, ground);
+        }
+
+        if (m_budgetTiles + tiles > m_settings.maxResidentTiles)
+        {
+            break;
+        }
+
+        m_budgetTiles += tiles;
+        m_states[candidate.region] = RegionState::Pending;
+        m_requestedAt[candidate.region] = now;
+        m_stats.pendingLoads++;
+        requested++;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back({candidate.region, &ground});
+    }
+
+    if (requested > 0)
+    {
+        m_wakeWorker.notify_one();
+    }
+
+    m_stats.loadsDeferred = m_candidates.size() - requested;
+    m_stats.residentRegions = m_resident.size();
+    m_stats.residentTiles = ground.getTileCount();
+    m_stats.residentBytes = ground.getResidentBytes();
+}
+
+const StreamingStats &LevelStreamer::getStats() const
+{
+    return m_stats;
+}
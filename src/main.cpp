@@ -1,4 +1,7 @@
 #include "Game.hpp"
+#include "core/Tracer.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #ifdef _WIN32
 #include <windows.h>
@@ -17,14 +20,38 @@ static std::filesystem::path getExecutableDirectory()
 #endif
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    // --trace captures from startup (asset loading included) until F4 or exit,
+    // --record <file> and --replay <file> save and play back a session's input,
+    // --lights <count> scatters extra lights over the level
+    GameOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--trace") == 0)
+        {
+            Tracer::start();
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            options.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            options.replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--lights") == 0 && i + 1 < argc)
+        {
+            options.testLights = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+
     // Ensure the working directory is the executable directory so relative
     // asset paths (e.g. "assets/..." from `include/Constants.hpp`) resolve
     // the same whether launched via installer shortcut or by double-clicking
     // the exe in File Explorer.
     std::filesystem::current_path(getExecutableDirectory());
 
-    Game game;
+    Game game(options);
     return game.run();
 }
\ No newline at end of file
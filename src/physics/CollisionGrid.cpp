@@ -0,0 +1,154 @@
+#include "physics/CollisionGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+CollisionGrid::CollisionGrid(float cellWidth, float cellHeight)
+    : m_cellWidth(cellWidth),
+      m_cellHeight(cellHeight)
+{
+}
+
+int CollisionGrid::cellX(float x) const
+{
+    return static_cast<int>(std::floor(x / m_cellWidth));
+}
+
+int CollisionGrid::cellY(float y) const
+{
+    return static_cast<int>(std::floor(y / m_cellHeight));
+}
+
+std::int64_t CollisionGrid::cellKey(int x, int y)
+{
+    return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+}
+
+void CollisionGrid::insert(const sf::FloatRect &box)
+{
+    std::uint32_t index = static_cast<std::uint32_t>(m_boxes.size());
+    m_boxes.push_back(box);
+
+    int minX = cellX(box.position.x);
+    int minY = cellY(box.position.y);
+    int maxX = cellX(box.position.x + box.size.x);
+    int maxY = cellY(box.position.y + box.size.y);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            m_cells[cellKey(x, y)].push_back(index);
+        }
+    }
+}
+
+bool CollisionGrid::remove(const sf::FloatRect &box)
+{
+    auto found = m_cells.find(cellKey(cellX(box.position.x), cellY(box.position.y)));
+    if (found == m_cells.end())
+    {
+        return false;
+    }
+
+    auto entry = std::find_if(found->second.begin(), found->second.end(), [&](std::uint32_t index)
+                              { return m_boxes[index] == box; });
+    if (entry == found->second.end())
+    {
+        return false;
+    }
+    std::uint32_t index = *entry;
+
+    // unlist it from every cell it touches
+    int minX = cellX(box.position.x);
+    int minY = cellY(box.position.y);
+    int maxX = cellX(box.position.x + box.size.x);
+    int maxY = cellY(box.position.y + box.size.y);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            auto cell = m_cells.find(cellKey(x, y));
+            std::vector<std::uint32_t> &indices = cell->second;
+            indices.erase(std::find(indices.begin(), indices.end(), index));
+            if (indices.empty())
+            {
+                m_cells.erase(cell);
+            }
+        }
+    }
+
+    // the last box takes the freed slot, relist it under its new index
+    std::uint32_t last = static_cast<std::uint32_t>(m_boxes.size() - 1);
+    if (index != last)
+    {
+        const sf::FloatRect &moved = m_boxes[last];
+        for (int y = cellY(moved.position.y); y <= cellY(moved.position.y + moved.size.y); y++)
+        {
+            for (int x = cellX(moved.position.x); x <= cellX(moved.position.x + moved.size.x); x++)
+            {
+                std::vector<std::uint32_t> &indices = m_cells[cellKey(x, y)];
+                *std::find(indices.begin(), indices.end(), last) = index;
+            }
+        }
+        m_boxes[index] = moved;
+    }
+    m_boxes.pop_back();
+    return true;
+}
+
+void CollisionGrid::clear()
+{
+    m_boxes.clear();
+    m_cells.clear();
+}
+
+void CollisionGrid::query(const sf::FloatRect &region, std::vector<sf::FloatRect> &out) const
+{
+    float regionRight = region.position.x + region.size.x;
+    float regionBottom = region.position.y + region.size.y;
+
+    int minX = cellX(region.position.x);
+    int minY = cellY(region.position.y);
+    int maxX = cellX(regionRight);
+    int maxY = cellY(regionBottom);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end())
+            {
+                continue;
+            }
+
+            for (std::uint32_t index : it->second)
+            {
+                const sf::FloatRect &box = m_boxes[index];
+
+                // a box spanning several visited cells is reported only from the
+                // first cell shared by the box and the region, no visited set needed
+                int firstX = std::max(cellX(box.position.x), minX);
+                int firstY = std::max(cellY(box.position.y), minY);
+                if (x != firstX || y != firstY)
+                {
+                    continue;
+                }
+
+                if (box.position.x > regionRight || box.position.x + box.size.x < region.position.x ||
+                    box.position.y > regionBottom || box.position.y + box.size.y < region.position.y)
+                {
+                    continue;
+                }
+
+                out.push_back(box);
+            }
+        }
+    }
+}
+
+const std::vector<sf::FloatRect> &CollisionGrid::getBoxes() const
+{
+    return m_boxes;
+}
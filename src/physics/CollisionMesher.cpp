@@ -0,0 +1,63 @@
+#include "physics/CollisionMesher.hpp"
+#include <algorithm>
+
+std::vector<sf::FloatRect> mergeCollisionBoxes(std::vector<sf::FloatRect> boxes)
+{
+    // Pass 1: horizontal runs (same top and height, touching or overlapping)
+    std::sort(boxes.begin(), boxes.end(), [](const sf::FloatRect &a, const sf::FloatRect &b)
+              {
+        if (a.position.y != b.position.y)
+            return a.position.y < b.position.y;
+        if (a.size.y != b.size.y)
+            return a.size.y < b.size.y;
+        return a.position.x < b.position.x; });
+
+    std::vector<sf::FloatRect> runs;
+    runs.reserve(boxes.size());
+
+    for (const sf::FloatRect &box : boxes)
+    {
+        if (!runs.empty())
+        {
+            sf::FloatRect &run = runs.back();
+            float runRight = run.position.x + run.size.x;
+
+            if (run.position.y == box.position.y && run.size.y == box.size.y && box.position.x <= runRight)
+            {
+                run.size.x = std::max(runRight, box.position.x + box.size.x) - run.position.x;
+                continue;
+            }
+        }
+        runs.push_back(box);
+    }
+
+    // Pass 2: stack runs with identical left edge and width into blocks
+    std::sort(runs.begin(), runs.end(), [](const sf::FloatRect &a, const sf::FloatRect &b)
+              {
+        if (a.position.x != b.position.x)
+            return a.position.x < b.position.x;
+        if (a.size.x != b.size.x)
+            return a.size.x < b.size.x;
+        return a.position.y < b.position.y; });
+
+    std::vector<sf::FloatRect> blocks;
+    blocks.reserve(runs.size());
+
+    for (const sf::FloatRect &run : runs)
+    {
+        if (!blocks.empty())
+        {
+            sf::FloatRect &block = blocks.back();
+            float blockBottom = block.position.y + block.size.y;
+
+            if (block.position.x == run.position.x && block.size.x == run.size.x && run.position.y <= blockBottom)
+            {
+                block.size.y = std::max(blockBottom, run.position.y + run.size.y) - block.position.y;
+                continue;
+            }
+        }
+        blocks.push_back(run);
+    }
+
+    return blocks;
+}
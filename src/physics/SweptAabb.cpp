@@ -0,0 +1,119 @@
+#include "physics/SweptAabb.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // entry and exit time of box along one axis, false if they never overlap on it
+    bool axisTimes(float boxMin, float boxMax, float obstacleMin, float obstacleMax, float motion, float &entry, float &exit)
+    {
+        if (motion == 0.f)
+        {
+            // apart or just touching on this axis, so never overlapping
+            if (boxMax <= obstacleMin + SWEEP_SKIN || boxMin >= obstacleMax - SWEEP_SKIN)
+            {
+                return false;
+            }
+
+            entry = -std::numeric_limits<float>::infinity();
+            exit = std::numeric_limits<float>::infinity();
+            return true;
+        }
+
+        float entryDistance = motion > 0.f ? obstacleMin - boxMax : obstacleMax - boxMin;
+        float exitDistance = motion > 0.f ? obstacleMax - boxMin : obstacleMin - boxMax;
+
+        // touching, or a hair inside from float error: contact right away
+        if (std::abs(entryDistance) < SWEEP_SKIN)
+        {
+            entryDistance = 0.f;
+        }
+
+        entry = entryDistance / motion;
+        exit = exitDistance / motion;
+        return true;
+    }
+}
+
+bool sweepBox(const sf::FloatRect &box, sf::Vector2f motion, const sf::FloatRect &obstacle, SweepHit &hit)
+{
+    float entryX, exitX, entryY, exitY;
+    if (!axisTimes(box.position.x, box.position.x + box.size.x, obstacle.position.x,
+                   obstacle.position.x + obstacle.size.x, motion.x, entryX, exitX) ||
+        !axisTimes(box.position.y, box.position.y + box.size.y, obstacle.position.y,
+                   obstacle.position.y + obstacle.size.y, motion.y, entryY, exitY))
+    {
+        return false;
+    }
+
+    float entry = std::max(entryX, entryY);
+    float exit = std::min(exitX, exitY);
+    if (entry >= exit || entry < 0.f || entry > 1.f)
+    {
+        return false;
+    }
+
+    hit.time = entry;
+
+    // the axis that comes into contact last is the one hit; ties land on
+    // the floor rather than catch on a corner
+    if (entryX > entryY)
+    {
+        hit.normal = {motion.x > 0.f ? -1.f : 1.f, 0.f};
+        hit.contact = motion.x > 0.f ? obstacle.position.x : obstacle.position.x + obstacle.size.x;
+    }
+    else
+    {
+        hit.normal = {0.f, motion.y > 0.f ? -1.f : 1.f};
+        hit.contact = motion.y > 0.f ? obstacle.position.y : obstacle.position.y + obstacle.size.y;
+    }
+
+    return true;
+}
+
+SlideResult sweepAndSlide(sf::FloatRect box, sf::Vector2f motion, const std::vector<sf::FloatRect> &obstacles)
+{
+    SlideResult result{box, false, false, false};
+
+    // each contact removes one axis of motion, so two passes resolve a
+    // corner; the third only picks up what float error leaves behind
+    for (int pass = 0; pass < 3 && (motion.x != 0.f || motion.y != 0.f); pass++)
+    {
+        SweepHit earliest{2.f, {0.f, 0.f}, 0.f};
+        for (const sf::FloatRect &obstacle : obstacles)
+        {
+            SweepHit hit;
+            if (sweepBox(result.box, motion, obstacle, hit) && hit.time < earliest.time)
+            {
+                earliest = hit;
+            }
+        }
+
+        if (earliest.time > 1.f)
+        {
+            result.box.position += motion;
+            break;
+        }
+
+        // move up to the contact, snap flush against the face, slide on
+        result.box.position += motion * earliest.time;
+        motion *= 1.f - earliest.time;
+
+        if (earliest.normal.x != 0.f)
+        {
+            result.box.position.x = earliest.normal.x < 0.f ? earliest.contact - result.box.size.x : earliest.contact;
+            motion.x = 0.f;
+            result.hitWall = true;
+        }
+        else
+        {
+            result.box.position.y = earliest.normal.y < 0.f ? earliest.contact - result.box.size.y : earliest.contact;
+            motion.y = 0.f;
+            result.hitFloor = result.hitFloor || earliest.normal.y < 0.f;
+            result.hitCeiling = result.hitCeiling || earliest.normal.y > 0.f;
+        }
+    }
+
+    return result;
+}
@@ -1,23 +1,40 @@
 #include <iostream>
+#include <algorithm>
 #include "scenes/MenuScene.hpp"
 
 Menu::Menu(float windowWidth, float windowHeight)
+    : selectedButton(-1),
+      loadingProgress(1.f)
 {
     // Background
     background.setSize({windowWidth, windowHeight});
     background.setFillColor(sf::Color(30, 30, 50));
+
+    // Loading bar
+    float barWidth = 300.f;
+    float barHeight = 8.f;
+    sf::Vector2f barPosition = {(windowWidth - barWidth) / 2.f, windowHeight - 50.f};
+
+    loadingBarBack.setSize({barWidth, barHeight});
+    loadingBarBack.setPosition(barPosition);
+    loadingBarBack.setFillColor(sf::Color(60, 60, 90));
+
+    loadingBarFill.setSize({0.f, barHeight});
+    loadingBarFill.setPosition(barPosition);
+    loadingBarFill.setFillColor(sf::Color(100, 100, 150));
 }
 
-bool Menu::loadFont(const std::string &fontPath)
+bool Menu::setFont(FontHandle menuFont)
 {
-    if (!font.openFromFile(fontPath))
+    if (!menuFont)
     {
         std::cerr << "Error loading font!" << std::endl;
         return false;
     }
+    font = std::move(menuFont);
 
     // Setup title
-    titleText.emplace(font, "I am not a hero", 80); // Buat objek sf::Text di dalam optional
+    titleText.emplace(*font, "I am not a hero", 80); // Buat objek sf::Text di dalam optional
     titleText->setFillColor(sf::Color::White);
     titleText->setStyle(sf::Text::Bold);
 
@@ -26,6 +43,11 @@ bool Menu::loadFont(const std::string &fontPath)
     titleText->setOrigin({titleBounds.size.x / 2.f, titleBounds.size.y / 2.f});
     titleText->setPosition({background.getSize().x / 2.f, 150.f});
 
+    // Setup loading label above the bar
+    loadingText.emplace(*font, "", 18);
+    loadingText->setFillColor(sf::Color(200, 200, 220));
+    loadingText->setPosition({loadingBarBack.getPosition().x, loadingBarBack.getPosition().y - 28.f});
+
     return true;
 }
 
@@ -41,7 +63,10 @@ Button *Menu::addButton(const std::string &text, float y)
         buttonWidth,
         buttonHeight);
 
-    button->setFont(font);
+    if (font)
+    {
+        button->setFont(*font);
+    }
     button->setText(text);
     button->setTextSize(30);
 
@@ -54,8 +79,21 @@ Button *Menu::addButton(const std::string &text, float y)
     return buttonPtr;
 }
 
+void Menu::setLoadingProgress(float progress)
+{
+    loadingProgress = std::min(std::max(progress, 0.f), 1.f);
+    loadingBarFill.setSize({loadingBarBack.getSize().x * loadingProgress, loadingBarBack.getSize().y});
+
+    if (loadingText)
+    {
+        loadingText->setString("Loading... " + std::to_string(static_cast<int>(loadingProgress * 100.f)) + "%");
+    }
+}
+
 void Menu::handleMouseMove(sf::Vector2f mousePos)
 {
+    // the mouse takes over from the keyboard focus
+    selectedButton = -1;
     for (auto &button : buttons)
     {
         button->handleMouseMove(mousePos);
@@ -78,6 +116,38 @@ void Menu::handleMouseRelease()
     }
 }
 
+void Menu::handleActions(const PlayerInput &input)
+{
+    if (buttons.empty())
+    {
+        return;
+    }
+
+    int count = static_cast<int>(buttons.size());
+    int previous = selectedButton;
+    if (input.wasPressed(Action::MenuDown))
+    {
+        selectedButton = selectedButton < 0 ? 0 : (selectedButton + 1) % count;
+    }
+    if (input.wasPressed(Action::MenuUp))
+    {
+        selectedButton = selectedButton < 0 ? count - 1 : (selectedButton + count - 1) % count;
+    }
+
+    if (selectedButton != previous)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            buttons[i]->setHovered(i == selectedButton);
+        }
+    }
+
+    if (selectedButton >= 0 && input.wasPressed(Action::MenuConfirm))
+    {
+        buttons[selectedButton]->click();
+    }
+}
+
 void Menu::draw(sf::RenderWindow &window)
 {
     window.draw(background);
@@ -91,4 +161,14 @@ void Menu::draw(sf::RenderWindow &window)
     {
         button->draw(window);
     }
+
+    if (loadingProgress < 1.f)
+    {
+        window.draw(loadingBarBack);
+        window.draw(loadingBarFill);
+        if (loadingText)
+        {
+            window.draw(*loadingText);
+        }
+    }
 }
\ No newline at end of file
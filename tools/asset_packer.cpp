@@ -0,0 +1,124 @@
+// Build-time asset packer. Collects every file under the given asset
+// directories into one pack file (format in include/core/AssetPack.hpp), keyed
+// by "assets/<path relative to the directory>". Later directories override
+// earlier ones, so generated assets can shadow source assets.
+//
+// usage: asset_packer <output pack> <asset dir> [asset dir...]
+#include "core/AssetPack.hpp"
+#include "core/LittleEndian.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using LittleEndian::writeU16;
+    using LittleEndian::writeU32;
+    using LittleEndian::writeU64;
+
+    std::uint64_t alignUp(std::uint64_t value)
+    {
+        return (value + PackFormat::BLOB_ALIGNMENT - 1) / PackFormat::BLOB_ALIGNMENT * PackFormat::BLOB_ALIGNMENT;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: asset_packer <output pack> <asset dir> [asset dir...]" << std::endl;
+        return 1;
+    }
+
+    // sorted by key so the same inputs always give the same pack
+    std::map<std::string, std::filesystem::path> files;
+    for (int i = 2; i < argc; i++)
+    {
+        std::filesystem::path root = argv[i];
+        if (!std::filesystem::is_directory(root))
+        {
+            std::cerr << "Not a directory: " << root.string() << std::endl;
+            return 1;
+        }
+
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(root))
+        {
+            if (entry.is_regular_file())
+            {
+                std::string key = "assets/" + std::filesystem::relative(entry.path(), root).generic_string();
+                files[key] = entry.path();
+            }
+        }
+    }
+
+    // Lay out header, table of contents, then aligned blobs
+    std::uint64_t tocSize = 0;
+    for (const auto &[key, path] : files)
+    {
+        tocSize += 18 + key.size();
+    }
+
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint64_t> sizes;
+    std::uint64_t cursor = alignUp(16 + tocSize);
+    for (const auto &[key, path] : files)
+    {
+        std::uint64_t size = std::filesystem::file_size(path);
+        offsets.push_back(cursor);
+        sizes.push_back(size);
+        cursor = alignUp(cursor + size);
+    }
+
+    std::filesystem::path outputPath = argv[1];
+    if (outputPath.has_parent_path())
+    {
+        std::filesystem::create_directories(outputPath.parent_path());
+    }
+
+    std::ofstream out(outputPath, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Error writing pack: " << outputPath.string() << std::endl;
+        return 1;
+    }
+
+    out.write(PackFormat::MAGIC, 8);
+    writeU32(out, PackFormat::VERSION);
+    writeU32(out, static_cast<std::uint32_t>(files.size()));
+
+    std::size_t index = 0;
+    for (const auto &[key, path] : files)
+    {
+        writeU64(out, offsets[index]);
+        writeU64(out, sizes[index]);
+        writeU16(out, static_cast<std::uint16_t>(key.size()));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        index++;
+    }
+
+    index = 0;
+    std::vector<char> buffer;
+    for (const auto &[key, path] : files)
+    {
+        // pad up to the blob's aligned offset
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        std::vector<char> padding(offsets[index] - position, 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        std::ifstream in(path, std::ios::binary);
+        buffer.resize(sizes[index]);
+        if (!in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+        {
+            std::cerr << "Error reading: " << path.string() << std::endl;
+            return 1;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        index++;
+    }
+
+    std::cout << "Packed " << files.size() << " files (" << cursor / 1024 << " KiB) into " << outputPath.string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,267 @@
+// Build-time sprite atlas packer. Reads a manifest of sprite sheets, cuts each
+// sheet into frames, shelf-packs the non-empty frames into as few pages as
+// possible and writes the pages as PNG plus a binary frame index that
+// SpriteAtlas loads at runtime (format in include/graphics/SpriteAtlas.hpp).
+//
+// usage: atlas_packer <manifest> <asset root> <output dir> <atlas name>
+#include "graphics/SpriteAtlas.hpp"
+#include "core/LittleEndian.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using LittleEndian::writeU16;
+    using LittleEndian::writeU32;
+
+    const unsigned int PAGE_SIZE = 2048;
+    const unsigned int PADDING = 1;
+
+    struct Sheet
+    {
+        std::string name;
+        std::string path;
+        unsigned int frameWidth;
+        unsigned int frameHeight;
+        sf::Image image;
+        std::uint32_t firstFrame;
+        std::uint32_t frameCount;
+    };
+
+    struct Frame
+    {
+        std::size_t sheet;
+        sf::Vector2u source;
+        sf::Vector2u size;
+        std::uint16_t page;
+        sf::Vector2u target;
+    };
+
+    bool isEmptyCell(const sf::Image &image, sf::Vector2u origin, sf::Vector2u size)
+    {
+        const std::uint8_t *pixels = image.getPixelsPtr();
+        unsigned int stride = image.getSize().x;
+
+        for (unsigned int y = origin.y; y < origin.y + size.y; y++)
+        {
+            for (unsigned int x = origin.x; x < origin.x + size.x; x++)
+            {
+                if (pixels[(static_cast<std::size_t>(y) * stride + x) * 4 + 3] != 0)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool readManifest(const std::string &manifestPath, const std::filesystem::path &assetRoot, std::vector<Sheet> &sheets)
+    {
+        std::ifstream manifest(manifestPath);
+        if (!manifest)
+        {
+            std::cerr << "Error opening manifest: " << manifestPath << std::endl;
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(manifest, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream fields(line);
+            Sheet sheet;
+            if (!(fields >> sheet.name >> sheet.frameWidth >> sheet.frameHeight))
+                continue;
+
+            // the rest of the line is the path, which may contain spaces
+            std::getline(fields >> std::ws, sheet.path);
+            sheet.path.erase(sheet.path.find_last_not_of(" \t\r") + 1);
+
+            if (!sheet.image.loadFromFile(assetRoot / sheet.path))
+            {
+                std::cerr << "Error loading sheet: " << sheet.path << std::endl;
+                return false;
+            }
+
+            sf::Vector2u size = sheet.image.getSize();
+            if (sheet.frameWidth == 0 || sheet.frameHeight == 0)
+            {
+                sheet.frameWidth = size.x;
+                sheet.frameHeight = size.y;
+            }
+            sheets.push_back(std::move(sheet));
+        }
+        return true;
+    }
+
+    void writeString(std::ostream &out, const std::string &value)
+    {
+        writeU16(out, static_cast<std::uint16_t>(value.size()));
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 5)
+    {
+        std::cerr << "usage: atlas_packer <manifest> <asset root> <output dir> <atlas name>" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path assetRoot = argv[2];
+    std::filesystem::path outputDir = argv[3];
+    std::string atlasName = argv[4];
+
+    std::vector<Sheet> sheets;
+    if (!readManifest(argv[1], assetRoot, sheets))
+        return 1;
+
+    // Cut sheets into cells, row-major, keeping a slot for empty cells
+    std::vector<Frame> frames;
+    for (std::size_t i = 0; i < sheets.size(); i++)
+    {
+        Sheet &sheet = sheets[i];
+        sf::Vector2u size = sheet.image.getSize();
+        unsigned int columns = size.x / sheet.frameWidth;
+        unsigned int rows = size.y / sheet.frameHeight;
+
+        sheet.firstFrame = static_cast<std::uint32_t>(frames.size());
+        sheet.frameCount = columns * rows;
+
+        for (unsigned int row = 0; row < rows; row++)
+        {
+            for (unsigned int column = 0; column < columns; column++)
+            {
+                sf::Vector2u source(column * sheet.frameWidth, row * sheet.frameHeight);
+                sf::Vector2u cellSize(sheet.frameWidth, sheet.frameHeight);
+                if (cellSize.x + PADDING > PAGE_SIZE || cellSize.y + PADDING > PAGE_SIZE)
+                {
+                    std::cerr << "Frame larger than an atlas page in: " << sheet.path << std::endl;
+                    return 1;
+                }
+                bool empty = isEmptyCell(sheet.image, source, cellSize);
+                frames.push_back({i, source, empty ? sf::Vector2u() : cellSize, 0, {}});
+            }
+        }
+    }
+
+    // Shelf packing, tallest frames first
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < frames.size(); i++)
+    {
+        if (frames[i].size.x > 0)
+            order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&frames](std::size_t a, std::size_t b)
+                     {
+        if (frames[a].size.y != frames[b].size.y)
+            return frames[a].size.y > frames[b].size.y;
+        return frames[a].size.x > frames[b].size.x; });
+
+    std::vector<sf::Vector2u> pageExtents(1);
+    unsigned int shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+    for (std::size_t index : order)
+    {
+        Frame &frame = frames[index];
+
+        if (shelfX + frame.size.x > PAGE_SIZE)
+        {
+            shelfX = 0;
+            shelfY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        if (shelfY + frame.size.y > PAGE_SIZE)
+        {
+            pageExtents.emplace_back();
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        frame.page = static_cast<std::uint16_t>(pageExtents.size() - 1);
+        frame.target = {shelfX, shelfY};
+
+        sf::Vector2u &extent = pageExtents.back();
+        extent.x = std::max(extent.x, shelfX + frame.size.x);
+        extent.y = std::max(extent.y, shelfY + frame.size.y);
+
+        shelfX += frame.size.x + PADDING;
+        shelfHeight = std::max(shelfHeight, frame.size.y);
+    }
+
+    // Compose and save pages, cropped to what they use
+    std::filesystem::create_directories(outputDir);
+    std::vector<std::string> pageNames;
+
+    for (std::size_t page = 0; page < pageExtents.size(); page++)
+    {
+        sf::Vector2u extent(std::max(pageExtents[page].x, 1u), std::max(pageExtents[page].y, 1u));
+        sf::Image pageImage(extent, sf::Color::Transparent);
+
+        for (const Frame &frame : frames)
+        {
+            if (frame.size.x == 0 || frame.page != page)
+                continue;
+
+            sf::IntRect sourceRect(sf::Vector2i(frame.source), sf::Vector2i(frame.size));
+            if (!pageImage.copy(sheets[frame.sheet].image, frame.target, sourceRect))
+            {
+                std::cerr << "Error copying frame from: " << sheets[frame.sheet].path << std::endl;
+                return 1;
+            }
+        }
+
+        std::string pageName = atlasName + "_" + std::to_string(page) + ".png";
+        if (!pageImage.saveToFile(outputDir / pageName))
+        {
+            std::cerr << "Error writing atlas page: " << pageName << std::endl;
+            return 1;
+        }
+        pageNames.push_back(pageName);
+    }
+
+    // Binary frame index
+    std::filesystem::path indexPath = outputDir / (atlasName + ".atlas");
+    std::ofstream index(indexPath, std::ios::binary);
+    if (!index)
+    {
+        std::cerr << "Error writing atlas index: " << indexPath.string() << std::endl;
+        return 1;
+    }
+
+    index.write(AtlasFormat::MAGIC, 8);
+    writeU32(index, AtlasFormat::VERSION);
+    writeU32(index, static_cast<std::uint32_t>(pageNames.size()));
+    writeU32(index, static_cast<std::uint32_t>(sheets.size()));
+    writeU32(index, static_cast<std::uint32_t>(frames.size()));
+
+    for (const std::string &pageName : pageNames)
+        writeString(index, pageName);
+
+    for (const Sheet &sheet : sheets)
+    {
+        writeString(index, sheet.name);
+        writeU32(index, sheet.firstFrame);
+        writeU32(index, sheet.frameCount);
+    }
+
+    for (const Frame &frame : frames)
+    {
+        writeU16(index, frame.page);
+        writeU16(index, static_cast<std::uint16_t>(frame.target.x));
+        writeU16(index, static_cast<std::uint16_t>(frame.target.y));
+        writeU16(index, static_cast<std::uint16_t>(frame.size.x));
+        writeU16(index, static_cast<std::uint16_t>(frame.size.y));
+    }
+
+    std::cout << "Packed " << sheets.size() << " sheets (" << order.size() << " frames) into "
+              << pageNames.size() << " page(s): " << indexPath.string() << std::endl;
+    return 0;
+}
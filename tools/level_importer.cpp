@@ -0,0 +1,731 @@
+// Level importer. Converts a Tiled map into the binary level format (see
+// include/level/Level.hpp) the game loads in one read.
+//
+// usage: level_importer <output.lvl> <map.json>
+//        level_importer <output.lvl> <tile width> <tile height> <tileset columns> <layer.csv>...
+//                       [--collision <layer.csv>] [--spawn <player|enemy|torch> <x> <y>]...
+//                       [--region-size <tiles>]
+//
+// JSON maps are Tiled's own format: orthogonal, one embedded tileset, tile
+// layer data as plain arrays (not base64). A tile layer named "collision",
+// or with a bool property "collision", becomes the collision layer; without
+// one every tile is solid. Point objects of type (or class) "player" or
+// "enemy" become spawns. An int map property "regionSize" sets the tiles
+// per streaming region side (a multiple of 16, default 32).
+//
+// CSV layers are Tiled's CSV export: one row of tile indices per line, -1
+// for an empty cell.
+#include "level/Level.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "usage: level_importer <output.lvl> <map.json>\n"
+                  << "       level_importer <output.lvl> <tile width> <tile height> <tileset columns> <layer.csv>...\n"
+                  << "                      [--collision <layer.csv>] [--spawn <player|enemy|torch> <x> <y>]...\n"
+                  << "                      [--region-size <tiles>]" << std::endl;
+    }
+
+    // a whole, positive multiple of 16 (the ground's chunk size), or the
+    // level would be written with regions the game refuses to stream
+    bool parseRegionSize(double value, std::uint32_t &regionSize)
+    {
+        if (!(value > 0.0) || value > static_cast<double>(std::numeric_limits<std::uint32_t>::max()) ||
+            value != static_cast<double>(static_cast<std::uint32_t>(value)) || static_cast<std::uint32_t>(value) % 16 != 0)
+        {
+            std::cerr << "Region size must be a positive multiple of 16, got " << value << std::endl;
+            printUsage();
+            return false;
+        }
+        regionSize = static_cast<std::uint32_t>(value);
+        return true;
+    }
+
+    struct JsonValue
+    {
+        enum class Type
+        {
+            Null,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        Type type = Type::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        const JsonValue *get(const std::string &key) const
+        {
+            for (const auto &[name, value] : members)
+            {
+                if (name == key)
+                {
+                    return &value;
+                }
+            }
+            return nullptr;
+        }
+
+        double numberOr(const std::string &key, double fallback) const
+        {
+            const JsonValue *value = get(key);
+            return value && value->type == Type::Number ? value->number : fallback;
+        }
+
+        std::string textOr(const std::string &key, const std::string &fallback) const
+        {
+            const JsonValue *value = get(key);
+            return value && value->type == Type::String ? value->text : fallback;
+        }
+    };
+
+    // just enough JSON for Tiled maps; \u escapes outside ASCII are dropped
+    class JsonParser
+    {
+    private:
+        const std::string &m_text;
+        std::size_t m_position;
+        std::string m_error;
+
+        void skipSpace()
+        {
+            while (m_position < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_position])))
+            {
+                m_position++;
+            }
+        }
+
+        bool fail(const std::string &message)
+        {
+            if (m_error.empty())
+            {
+                m_error = message + " at offset " + std::to_string(m_position);
+            }
+            return false;
+        }
+
+        bool expect(char c)
+        {
+            skipSpace();
+            if (m_position < m_text.size() && m_text[m_position] == c)
+            {
+                m_position++;
+                return true;
+            }
+            return fail(std::string("expected '") + c + "'");
+        }
+
+        bool parseString(std::string &out)
+        {
+            if (!expect('"'))
+            {
+                return false;
+            }
+
+            while (m_position < m_text.size() && m_text[m_position] != '"')
+            {
+                char c = m_text[m_position++];
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+                if (m_position >= m_text.size())
+                {
+                    break;
+                }
+
+                char escaped = m_text[m_position++];
+                switch (escaped)
+                {
+                case 'n':
+                    out += '\n';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'u':
+                {
+                    if (m_position + 4 > m_text.size())
+                    {
+                        return fail("bad \\u escape");
+                    }
+                    unsigned long code = std::strtoul(m_text.substr(m_position, 4).c_str(), nullptr, 16);
+                    m_position += 4;
+                    if (code < 0x80)
+                    {
+                        out += static_cast<char>(code);
+                    }
+                    break;
+                }
+                default:
+                    out += escaped;
+                    break;
+                }
+            }
+
+            if (m_position >= m_text.size())
+            {
+                return fail("unterminated string");
+            }
+            m_position++;
+            return true;
+        }
+
+        bool parseValue(JsonValue &out)
+        {
+            skipSpace();
+            if (m_position >= m_text.size())
+            {
+                return fail("unexpected end");
+            }
+
+            char c = m_text[m_position];
+            if (c == '{')
+            {
+                out.type = JsonValue::Type::Object;
+                m_position++;
+                skipSpace();
+                if (m_position < m_text.size() && m_text[m_position] == '}')
+                {
+                    m_position++;
+                    return true;
+                }
+                while (true)
+                {
+                    std::pair<std::string, JsonValue> member;
+                    if (!parseString(member.first) || !expect(':') || !parseValue(member.second))
+                    {
+                        return false;
+                    }
+                    out.members.push_back(std::move(member));
+
+                    skipSpace();
+                    if (m_position < m_text.size() && m_text[m_position] == ',')
+                    {
+                        m_position++;
+                        continue;
+                    }
+                    return expect('}');
+                }
+            }
+
+            if (c == '[')
+            {
+                out.type = JsonValue::Type::Array;
+                m_position++;
+                skipSpace();
+                if (m_position < m_text.size() && m_text[m_position] == ']')
+                {
+                    m_position++;
+                    return true;
+                }
+                while (true)
+                {
+                    out.items.emplace_back();
+                    if (!parseValue(out.items.back()))
+                    {
+                        return false;
+                    }
+
+                    skipSpace();
+                    if (m_position < m_text.size() && m_text[m_position] == ',')
+                    {
+                        m_position++;
+                        continue;
+                    }
+                    return expect(']');
+                }
+            }
+
+            if (c == '"')
+            {
+                out.type = JsonValue::Type::String;
+                return parseString(out.text);
+            }
+
+            for (const char *keyword : {"true", "false", "null"})
+            {
+                std::string word = keyword;
+                if (m_text.compare(m_position, word.size(), word) == 0)
+                {
+                    m_position += word.size();
+                    out.type = word == "null" ? JsonValue::Type::Null : JsonValue::Type::Bool;
+                    out.boolean = word == "true";
+                    return true;
+                }
+            }
+
+            const char *start = m_text.c_str() + m_position;
+            char *end = nullptr;
+            out.number = std::strtod(start, &end);
+            if (end == start)
+            {
+                return fail("unexpected character");
+            }
+            out.type = JsonValue::Type::Number;
+            m_position += static_cast<std::size_t>(end - start);
+            return true;
+        }
+
+    public:
+        explicit JsonParser(const std::string &text)
+            : m_text(text),
+              m_position(0)
+        {
+        }
+
+        bool parse(JsonValue &out)
+        {
+            if (!parseValue(out))
+            {
+                return false;
+            }
+            skipSpace();
+            return m_position == m_text.size() || fail("trailing characters");
+        }
+
+        const std::string &getError() const
+        {
+            return m_error;
+        }
+    };
+
+    bool readText(const std::string &path, std::string &out)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            std::cerr << "Error opening " << path << std::endl;
+            return false;
+        }
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        out = contents.str();
+        return true;
+    }
+
+    bool parseSpawnKind(const std::string &name, SpawnKind &kind)
+    {
+        if (name == "player")
+        {
+            kind = SpawnKind::Player;
+            return true;
+        }
+        if (name == "enemy")
+        {
+            kind = SpawnKind::Enemy;
+            return true;
+        }
+        if (name == "torch")
+        {
+            kind = SpawnKind::Torch;
+            return true;
+        }
+        return false;
+    }
+
+    // a Tiled custom property of a map, layer or object, nullptr if unset
+    const JsonValue *findProperty(const JsonValue &owner, const std::string &name)
+    {
+        const JsonValue *properties = owner.get("properties");
+        if (properties && properties->type == JsonValue::Type::Array)
+        {
+            for (const JsonValue &property : properties->items)
+            {
+                if (property.textOr("name", "") == name)
+                {
+                    return property.get("value");
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    bool isCollisionLayer(const JsonValue &layer)
+    {
+        if (layer.textOr("name", "") == "collision")
+        {
+            return true;
+        }
+
+        const JsonValue *value = findProperty(layer, "collision");
+        return value && value->type == JsonValue::Type::Bool && value->boolean;
+    }
+
+    bool importJson(const std::string &path, Level &level)
+    {
+        std::string text;
+        if (!readText(path, text))
+        {
+            return false;
+        }
+
+        JsonValue map;
+        JsonParser parser(text);
+        if (!parser.parse(map) || map.type != JsonValue::Type::Object)
+        {
+            std::cerr << path << ": invalid JSON: " << parser.getError() << std::endl;
+            return false;
+        }
+
+        if (map.textOr("orientation", "orthogonal") != "orthogonal" || (map.get("infinite") && map.get("infinite")->boolean))
+        {
+            std::cerr << path << ": only finite orthogonal maps are supported" << std::endl;
+            return false;
+        }
+
+        const JsonValue *tilesets = map.get("tilesets");
+        if (!tilesets || tilesets->type != JsonValue::Type::Array || tilesets->items.size() != 1)
+        {
+            std::cerr << path << ": expected exactly one tileset" << std::endl;
+            return false;
+        }
+
+        const JsonValue &tileset = tilesets->items[0];
+        std::uint32_t firstGid = static_cast<std::uint32_t>(tileset.numberOr("firstgid", 1));
+        std::uint32_t columns = static_cast<std::uint32_t>(tileset.numberOr("columns", 0));
+        if (columns == 0)
+        {
+            std::cerr << path << ": the tileset has to be embedded (no \"columns\")" << std::endl;
+            return false;
+        }
+
+        std::uint32_t width = static_cast<std::uint32_t>(map.numberOr("width", 0));
+        std::uint32_t height = static_cast<std::uint32_t>(map.numberOr("height", 0));
+        std::uint32_t tileWidth = static_cast<std::uint32_t>(map.numberOr("tilewidth", 0));
+        std::uint32_t tileHeight = static_cast<std::uint32_t>(map.numberOr("tileheight", 0));
+
+        const JsonValue *layers = map.get("layers");
+        if (width == 0 || height == 0 || tileWidth == 0 || tileHeight == 0 || !layers || layers->type != JsonValue::Type::Array)
+        {
+            std::cerr << path << ": missing map size, tile size or layers" << std::endl;
+            return false;
+        }
+
+        std::vector<const JsonValue *> tileLayers;
+        const JsonValue *collisionLayer = nullptr;
+        for (const JsonValue &layer : layers->items)
+        {
+            if (layer.textOr("type", "") != "tilelayer")
+            {
+                continue;
+            }
+
+            const JsonValue *data = layer.get("data");
+            if (layer.textOr("encoding", "csv") != "csv" || !data || data->type != JsonValue::Type::Array ||
+                data->items.size() != static_cast<std::size_t>(width) * height)
+            {
+                std::cerr << path << ": layer \"" << layer.textOr("name", "") << "\" needs plain array data of the map size" << std::endl;
+                return false;
+            }
+
+            if (isCollisionLayer(layer))
+            {
+                collisionLayer = &layer;
+            }
+            else
+            {
+                tileLayers.push_back(&layer);
+            }
+        }
+
+        level.create(width, height, tileWidth, tileHeight, columns, static_cast<std::uint32_t>(tileLayers.size()),
+                     collisionLayer != nullptr);
+
+        const JsonValue *regionSize = findProperty(map, "regionSize");
+        if (regionSize && regionSize->type == JsonValue::Type::Number)
+        {
+            std::uint32_t tiles;
+            if (!parseRegionSize(regionSize->number, tiles))
+            {
+                return false;
+            }
+            level.setRegionSize(tiles);
+        }
+
+        // flip and rotation bits live at the top of a gid, the game does not use them
+        const std::uint32_t GID_MASK = 0x1FFFFFFFu;
+
+        for (std::uint32_t layer = 0; layer < tileLayers.size(); layer++)
+        {
+            const std::vector<JsonValue> &cells = tileLayers[layer]->get("data")->items;
+            for (std::size_t i = 0; i < cells.size(); i++)
+            {
+                std::uint32_t gid = static_cast<std::uint32_t>(cells[i].number) & GID_MASK;
+                if (gid == 0)
+                {
+                    continue;
+                }
+                if (gid < firstGid || gid - firstGid + 1 > std::numeric_limits<std::uint16_t>::max())
+                {
+                    std::cerr << path << ": tile " << gid << " is outside the tileset" << std::endl;
+                    return false;
+                }
+                level.setTile(layer, static_cast<std::uint32_t>(i % width), static_cast<std::uint32_t>(i / width),
+                              static_cast<std::uint16_t>(gid - firstGid + 1));
+            }
+        }
+
+        if (collisionLayer)
+        {
+            const std::vector<JsonValue> &cells = collisionLayer->get("data")->items;
+            for (std::size_t i = 0; i < cells.size(); i++)
+            {
+                level.setSolid(static_cast<std::uint32_t>(i % width), static_cast<std::uint32_t>(i / width), cells[i].number != 0.0);
+            }
+        }
+
+        for (const JsonValue &layer : layers->items)
+        {
+            const JsonValue *objects = layer.get("objects");
+            if (layer.textOr("type", "") != "objectgroup" || !objects)
+            {
+                continue;
+            }
+
+            for (const JsonValue &object : objects->items)
+            {
+                // Tiled 1.9 renamed an object's "type" to "class"
+                std::string kindName = object.textOr("type", "");
+                if (kindName.empty())
+                {
+                    kindName = object.textOr("class", "");
+                }
+
+                SpawnKind kind;
+                if (!parseSpawnKind(kindName, kind))
+                {
+                    std::cerr << path << ": skipping object of unknown type \"" << kindName << "\"" << std::endl;
+                    continue;
+                }
+                level.addSpawn(kind, {static_cast<float>(object.numberOr("x", 0)), static_cast<float>(object.numberOr("y", 0))});
+            }
+        }
+
+        return true;
+    }
+
+    // rows of comma separated tile indices, -1 for empty
+    bool readCsvLayer(const std::string &path, std::vector<std::vector<int>> &rows)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            std::cerr << "Error opening " << path << std::endl;
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::vector<int> row;
+            std::istringstream fields(line);
+            std::string field;
+            while (std::getline(fields, field, ','))
+            {
+                if (field.find_first_not_of(" \t\r") == std::string::npos)
+                {
+                    continue;
+                }
+                row.push_back(std::atoi(field.c_str()));
+            }
+            if (!row.empty())
+            {
+                rows.push_back(std::move(row));
+            }
+        }
+
+        if (rows.empty())
+        {
+            std::cerr << path << ": no cells" << std::endl;
+            return false;
+        }
+        for (const std::vector<int> &row : rows)
+        {
+            if (row.size() != rows[0].size())
+            {
+                std::cerr << path << ": rows have different lengths" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool importCsv(int argc, char **argv, Level &level)
+    {
+        std::uint32_t tileWidth = static_cast<std::uint32_t>(std::atoi(argv[2]));
+        std::uint32_t tileHeight = static_cast<std::uint32_t>(std::atoi(argv[3]));
+        std::uint32_t columns = static_cast<std::uint32_t>(std::atoi(argv[4]));
+        if (tileWidth == 0 || tileHeight == 0 || columns == 0)
+        {
+            std::cerr << "Tile size and tileset columns must be positive" << std::endl;
+            return false;
+        }
+
+        std::vector<std::vector<std::vector<int>>> layers;
+        std::vector<std::vector<int>> collision;
+        std::vector<LevelSpawn> spawns;
+        std::uint32_t regionSize = LevelFormat::DEFAULT_REGION_SIZE;
+
+        for (int i = 5; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            if (argument == "--region-size" && i + 1 < argc)
+            {
+                // strtod, so "abc" or "32x" is refused rather than read as 0 or 32
+                char *end = nullptr;
+                const char *text = argv[++i];
+                double value = std::strtod(text, &end);
+                if (end == text || *end != '\0')
+                {
+                    std::cerr << "Region size must be a number, got " << text << std::endl;
+                    printUsage();
+                    return false;
+                }
+                if (!parseRegionSize(value, regionSize))
+                {
+                    return false;
+                }
+            }
+            else if (argument == "--collision" && i + 1 < argc)
+            {
+                if (!readCsvLayer(argv[++i], collision))
+                {
+                    return false;
+                }
+            }
+            else if (argument == "--spawn" && i + 3 < argc)
+            {
+                SpawnKind kind;
+                if (!parseSpawnKind(argv[i + 1], kind))
+                {
+                    std::cerr << "Unknown spawn kind: " << argv[i + 1] << std::endl;
+                    return false;
+                }
+                spawns.push_back({kind, {std::strtof(argv[i + 2], nullptr), std::strtof(argv[i + 3], nullptr)}});
+                i += 3;
+            }
+            else
+            {
+                layers.emplace_back();
+                if (!readCsvLayer(argument, layers.back()))
+                {
+                    return false;
+                }
+            }
+        }
+
+        const std::vector<std::vector<int>> &reference = layers.empty() ? collision : layers[0];
+        if (reference.empty())
+        {
+            std::cerr << "No layers given" << std::endl;
+            return false;
+        }
+
+        std::uint32_t width = static_cast<std::uint32_t>(reference[0].size());
+        std::uint32_t height = static_cast<std::uint32_t>(reference.size());
+        if (!collision.empty() && (collision.size() != height || collision[0].size() != width))
+        {
+            std::cerr << "The collision layer is not the size of the map" << std::endl;
+            return false;
+        }
+        for (const std::vector<std::vector<int>> &grid : layers)
+        {
+            if (grid.size() != height || grid[0].size() != width)
+            {
+                std::cerr << "Layers have different sizes" << std::endl;
+                return false;
+            }
+        }
+
+        level.create(width, height, tileWidth, tileHeight, columns, static_cast<std::uint32_t>(layers.size()), !collision.empty());
+        level.setRegionSize(regionSize);
+
+        for (std::uint32_t layer = 0; layer < layers.size(); layer++)
+        {
+            for (std::uint32_t y = 0; y < height; y++)
+            {
+                for (std::uint32_t x = 0; x < width; x++)
+                {
+                    int index = layers[layer][y][x];
+                    if (index < 0)
+                    {
+                        continue;
+                    }
+                    if (index + 1 > std::numeric_limits<std::uint16_t>::max())
+                    {
+                        std::cerr << "Tile index " << index << " is too large" << std::endl;
+                        return false;
+                    }
+                    level.setTile(layer, x, y, static_cast<std::uint16_t>(index + 1));
+                }
+            }
+        }
+
+        for (std::uint32_t y = 0; y < height && !collision.empty(); y++)
+        {
+            for (std::uint32_t x = 0; x < width; x++)
+            {
+                level.setSolid(x, y, collision[y][x] >= 0);
+            }
+        }
+
+        for (const LevelSpawn &spawn : spawns)
+        {
+            level.addSpawn(spawn.kind, spawn.position);
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool json = argc == 3 && std::string(argv[2]).size() > 5 &&
+                std::string(argv[2]).compare(std::string(argv[2]).size() - 5, 5, ".json") == 0;
+    if (!json && argc < 6)
+    {
+        printUsage();
+        return 1;
+    }
+
+    Level level;
+    if (!(json ? importJson(argv[2], level) : importCsv(argc, argv, level)))
+    {
+        return 1;
+    }
+
+    if (!level.saveToFile(argv[1]))
+    {
+        return 1;
+    }
+
+    std::cout << "Imported " << level.getWidth() << "x" << level.getHeight() << " tiles, "
+              << level.getLayerCount() << " layers, " << level.getSpawns().size() << " spawns into " << argv[1] << std::endl;
+    return 0;
+}